@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2020, 2022, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2020, 2026, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -46,6 +46,29 @@ static jfieldID handleID;
 static jfieldID jniVersionID;
 static void *procHandle;
 
+/*
+ * Cache of symbol lookups, keyed by library handle and symbol name.
+ * Lookups that fail are cached too, except in the process handle, to
+ * which libraries loaded later add symbols. The entries of a library
+ * are removed when it is unloaded.
+ */
+#define SYMBOL_CACHE_BUCKETS        512
+#define SYMBOL_CACHE_MAX_ENTRIES    8192
+
+typedef struct SymbolEntry {
+    struct SymbolEntry *next;
+    void *handle;
+    void *address;
+    unsigned int hash;
+    char name[1];
+} SymbolEntry;
+
+static SymbolEntry *symbolCache[SYMBOL_CACHE_BUCKETS];
+static int symbolCount;
+
+/* The cache is guarded by the monitor of the NativeLibrary class */
+static jclass symbolCacheLock;
+
 static jboolean initIDs(JNIEnv *env)
 {
     if (handleID == 0) {
@@ -65,6 +88,138 @@ static jboolean initIDs(JNIEnv *env)
 }
 
 
+static jboolean lockSymbolCache(JNIEnv *env)
+{
+    if (symbolCacheLock == NULL) {
+        jclass cls = (*env)->FindClass(env, "jdk/internal/loader/NativeLibrary");
+        if (cls == NULL) {
+            (*env)->ExceptionClear(env);
+            return JNI_FALSE;
+        }
+        /* racing threads all store a reference to the same class */
+        symbolCacheLock = (jclass)(*env)->NewGlobalRef(env, cls);
+        (*env)->DeleteLocalRef(env, cls);
+        if (symbolCacheLock == NULL) {
+            (*env)->ExceptionClear(env);
+            return JNI_FALSE;
+        }
+    }
+    if ((*env)->MonitorEnter(env, symbolCacheLock) != JNI_OK) {
+        (*env)->ExceptionClear(env);
+        return JNI_FALSE;
+    }
+    return JNI_TRUE;
+}
+
+static void unlockSymbolCache(JNIEnv *env)
+{
+    (*env)->MonitorExit(env, symbolCacheLock);
+}
+
+static unsigned int symbolHash(void *handle, const char *name)
+{
+    unsigned int hash = (unsigned int)(ptr_to_jlong(handle) >> 4);
+    const unsigned char *p;
+    for (p = (const unsigned char *)name; *p != '\0'; p++) {
+        hash = 31 * hash + *p;
+    }
+    return hash;
+}
+
+static SymbolEntry *lookupSymbolEntry(void *handle, const char *name,
+                                      unsigned int hash)
+{
+    SymbolEntry *e = symbolCache[hash % SYMBOL_CACHE_BUCKETS];
+    for (; e != NULL; e = e->next) {
+        if (e->hash == hash && e->handle == handle &&
+            strcmp(e->name, name) == 0) {
+            return e;
+        }
+    }
+    return NULL;
+}
+
+static void clearSymbolCache(void *handle)
+{
+    int i;
+    for (i = 0; i < SYMBOL_CACHE_BUCKETS; i++) {
+        SymbolEntry **prev = &symbolCache[i];
+        SymbolEntry *e;
+        while ((e = *prev) != NULL) {
+            if (handle == NULL || e->handle == handle) {
+                *prev = e->next;
+                free(e);
+                symbolCount--;
+            } else {
+                prev = &e->next;
+            }
+        }
+    }
+}
+
+/*
+ * Same as JVM_FindLibraryEntry, but remembers the result.
+ */
+static void *findLibraryEntry(JNIEnv *env, void *handle, const char *name)
+{
+    unsigned int hash = symbolHash(handle, name);
+    SymbolEntry *e;
+    void *address;
+    size_t len;
+
+    if (lockSymbolCache(env)) {
+        e = lookupSymbolEntry(handle, name, hash);
+        address = (e != NULL) ? e->address : NULL;
+        unlockSymbolCache(env);
+        if (e != NULL) {
+            return address;
+        }
+    }
+
+    address = JVM_FindLibraryEntry(handle, name);
+    if (address == NULL && handle == getProcessHandle()) {
+        return NULL;
+    }
+
+    len = strlen(name);
+    e = (SymbolEntry *)malloc(sizeof(SymbolEntry) + len);
+    if (e == NULL) {
+        return address;
+    }
+    e->handle = handle;
+    e->address = address;
+    e->hash = hash;
+    memcpy(e->name, name, len + 1);
+    if (!lockSymbolCache(env)) {
+        free(e);
+        return address;
+    }
+    if (lookupSymbolEntry(handle, name, hash) != NULL) {
+        free(e);
+    } else {
+        if (symbolCount >= SYMBOL_CACHE_MAX_ENTRIES) {
+            clearSymbolCache(NULL);
+        }
+        e->next = symbolCache[hash % SYMBOL_CACHE_BUCKETS];
+        symbolCache[hash % SYMBOL_CACHE_BUCKETS] = e;
+        symbolCount++;
+    }
+    unlockSymbolCache(env);
+    return address;
+}
+
+/*
+ * Forgets the symbols of a library that is about to be unloaded, as its
+ * handle may be reused for another library.
+ */
+void purgeLibraryEntries(JNIEnv *env, void *handle)
+{
+    if (lockSymbolCache(env)) {
+        clearSymbolCache(handle);
+        unlockSymbolCache(env);
+    }
+}
+
 /*
  * Support for finding JNI_On(Un)Load_<lib_name> if it exists.
  * If cname == NULL then just find normal JNI_On(Un)Load entry point
@@ -100,7 +255,7 @@ static void *findJniFunction(JNIEnv *env, void *handle,
             goto done;
         }
         buildJniFunctionName(syms[i], cname, jniFunctionName);
-        entryName = JVM_FindLibraryEntry(handle, jniFunctionName);
+        entryName = findLibraryEntry(env, handle, jniFunctionName);
         free(jniFunctionName);
         if(entryName) {
             break;
@@ -133,7 +288,9 @@ Java_jdk_internal_loader_NativeLibraries_load
     cname = JNU_GetStringPlatformChars(env, name, 0);
     if (cname == 0)
         return JNI_FALSE;
+    JNU_StartupEvent("NativeLibraries_load", JNI_TRUE);
     handle = isBuiltin ? procHandle : JVM_LoadLibrary(cname, throwExceptionIfFail);
+    JNU_StartupEvent("NativeLibraries_load", JNI_FALSE);
     if (handle) {
         JNI_OnLoad_t JNI_OnLoad;
         JNI_OnLoad = (JNI_OnLoad_t)findJniFunction(env, handle,
@@ -142,7 +299,9 @@ Java_jdk_internal_loader_NativeLibraries_load
         if (JNI_OnLoad) {
             JavaVM *jvm;
             (*env)->GetJavaVM(env, &jvm);
+            JNU_StartupEvent("JNI_OnLoad", JNI_TRUE);
             jniVersion = (*JNI_OnLoad)(jvm, NULL);
+            JNU_StartupEvent("JNI_OnLoad", JNI_FALSE);
         } else {
             jniVersion = 0x00010001;
         }
@@ -152,6 +311,7 @@ Java_jdk_internal_loader_NativeLibraries_load
             (*env)->ExceptionClear(env);
             (*env)->Throw(env, cause);
             if (!isBuiltin) {
+                purgeLibraryEntries(env, handle);
                 JVM_UnloadLibrary(handle);
             }
             goto done;
@@ -165,6 +325,7 @@ Java_jdk_internal_loader_NativeLibraries_load
                          jniVersion, cname);
             JNU_ThrowByName(env, "java/lang/UnsatisfiedLinkError", msg);
             if (!isBuiltin) {
+                purgeLibraryEntries(env, handle);
                 JVM_UnloadLibrary(handle);
             }
             goto done;
@@ -224,6 +385,7 @@ Java_jdk_internal_loader_NativeLibraries_unload
         (*JNI_OnUnload)(jvm, NULL);
     }
     if (!isBuiltin) {
+        purgeLibraryEntries(env, handle);
         JVM_UnloadLibrary(handle);
     }
     JNU_ReleaseStringPlatformChars(env, name, cname);
@@ -244,11 +406,58 @@ Java_jdk_internal_loader_NativeLibrary_findEntry0
     cname = (*env)->GetStringUTFChars(env, name, 0);
     if (cname == 0)
         return jlong_zero;
-    res = ptr_to_jlong(JVM_FindLibraryEntry(jlong_to_ptr(handle), cname));
+    res = ptr_to_jlong(findLibraryEntry(env, jlong_to_ptr(handle), cname));
     (*env)->ReleaseStringUTFChars(env, name, cname);
     return res;
 }
 
+/*
+ * Looks up several symbols of a library at once. The address of a
+ * symbol that is not found is 0.
+ *
+ * Class:     jdk_internal_loader_NativeLibrary
+ * Method:    findEntries0
+ * Signature: (J[Ljava/lang/String;)[J
+ */
+JNIEXPORT jlongArray JNICALL
+Java_jdk_internal_loader_NativeLibrary_findEntries0
+  (JNIEnv *env, jclass cls, jlong handle, jobjectArray names)
+{
+    jsize count = (*env)->GetArrayLength(env, names);
+    jlongArray result;
+    jlong *addresses;
+    jsize i;
+
+    result = (*env)->NewLongArray(env, count);
+    if (result == NULL || count == 0) {
+        return result;
+    }
+    addresses = (jlong *)calloc(count, sizeof(jlong));
+    if (addresses == NULL) {
+        JNU_ThrowOutOfMemoryError(env, NULL);
+        return NULL;
+    }
+    for (i = 0; i < count; i++) {
+        jstring name = (jstring)(*env)->GetObjectArrayElement(env, names, i);
+        const char *cname;
+        if (name == NULL) {
+            continue;
+        }
+        cname = (*env)->GetStringUTFChars(env, name, 0);
+        if (cname == NULL) {
+            free(addresses);
+            return NULL;
+        }
+        addresses[i] = ptr_to_jlong(findLibraryEntry(env, jlong_to_ptr(handle),
+                                                     cname));
+        (*env)->ReleaseStringUTFChars(env, name, cname);
+        (*env)->DeleteLocalRef(env, name);
+    }
+    (*env)->SetLongArrayRegion(env, result, 0, count, addresses);
+    free(addresses);
+    return result;
+}
+
 /*
  * Class:     jdk_internal_loader_NativeLibraries
  * Method:    findBuiltinLib
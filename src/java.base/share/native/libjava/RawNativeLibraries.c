@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2022, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2022, 2026, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -93,6 +93,7 @@ JNIEXPORT void JNICALL Java_jdk_internal_loader_RawNativeLibraries_unload0
     }
     handle = jlong_to_ptr(address);
 
+    purgeLibraryEntries(env, handle);
     JVM_UnloadLibrary(handle);
     JNU_ReleaseStringPlatformChars(env, name, cname);
 }
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 1997, 2023, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 1997, 2026, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -1251,3 +1251,21 @@ JNU_GetStaticFieldByName(JNIEnv *env,
     }
     return result;
 }
+
+typedef void (JNICALL *StartupEvent_t)(const char *phase, jboolean begin);
+
+JNIEXPORT void JNICALL
+JNU_StartupEvent(const char *phase, jboolean begin)
+{
+    static StartupEvent_t startupEvent = NULL;
+    static jboolean resolved = JNI_FALSE;
+
+    /* Racing threads resolve the same function */
+    if (!resolved) {
+        startupEvent = (StartupEvent_t) findStartupEventFunction();
+        resolved = JNI_TRUE;
+    }
+    if (startupEvent != NULL) {
+        (*startupEvent)(phase, begin);
+    }
+}
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 1997, 2023, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 1997, 2026, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -361,9 +361,28 @@ JNIEXPORT void InitializeEncoding(JNIEnv *env, const char *name);
 
 void* getProcessHandle();
 
+/*
+ * Returns the launcher's JLI_StartupEvent, or NULL if it is not present.
+ */
+void* findStartupEventFunction();
+
+/*
+ * Records the begin or end of a startup phase in the java launcher's
+ * startup timeline, see JDK_JAVA_STARTUP_TRACE.  Does nothing when the
+ * process was not started by the java launcher.  The phase name must be
+ * a string literal.
+ */
+JNIEXPORT void JNICALL
+JNU_StartupEvent(const char *phase, jboolean begin);
+
 void buildJniFunctionName(const char *sym, const char *cname,
                           char *jniEntryName);
 
+/*
+ * Removes the cached symbols of a native library before it is unloaded.
+ */
+void purgeLibraryEntries(JNIEnv *env, void *handle);
+
 #if defined(_AIX)
 void *findEntryInProcess(const char *name);
 #endif /* defined(_AIX) */
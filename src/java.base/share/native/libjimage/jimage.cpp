@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2015, 2019, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2015, 2026, Oracle and/or its affiliates. All rights reserved.
  *
  * Redistribution and use in source and binary forms, with or without
  * modification, are permitted provided that the following conditions
@@ -34,6 +34,7 @@
 #include "jimage.hpp"
 
 #include "imageFile.hpp"
+#include "osSupport.hpp"
 
 /*
  * JImageOpen - Given the supplied full path file name, open an image file. This
@@ -59,7 +60,9 @@ extern "C" JNIEXPORT JImageFile*
 JIMAGE_Open(const char *name, jint* error) {
     // TODO - return a meaningful error code
     *error = 0;
+    osSupport::startup_event("JIMAGE_Open", true);
     ImageFileReader* jfile = ImageFileReader::open(name);
+    osSupport::startup_event("JIMAGE_Open", false);
     return (JImageFile*) jfile;
 }
 
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2015, 2016, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2015, 2026, Oracle and/or its affiliates. All rights reserved.
  *
  * Redistribution and use in source and binary forms, with or without
  * modification, are permitted provided that the following conditions
@@ -71,6 +71,12 @@ public:
      * Unmap nBytes of memory at address.
      */
     static int unmap_memory(void* addr, size_t bytes);
+
+    /**
+     * Record the begin or end of a startup phase in the java launcher's
+     * startup timeline, if there is one.
+     */
+    static void startup_event(const char *phase, bool begin);
 };
 
 /**
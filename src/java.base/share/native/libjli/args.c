@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2015, 2022, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2015, 2026, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -440,7 +440,9 @@ JLI_PreprocessArg(const char *arg, jboolean expandSourceOpt) {
         checkArg(arg);
         JLI_List_add(rv, JLI_StringDup(arg));
     } else {
+        JLI_StartupBegin("ArgFile");
         rv = expandArgFile(arg);
+        JLI_StartupEnd("ArgFile");
     }
     return rv;
 }
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 1995, 2023, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 1995, 2026, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -274,6 +274,11 @@ JLI_Launch(int argc, char ** argv,              /* main argc, argv */
         AddOption("-Dsun.java.launcher.diag=true", NULL);
     }
 
+    /* Opt-in: let a pre-initialized VM run the program instead */
+    if (ZygoteLaunch(lname, argc, argv, &ret)) {
+        return ret;
+    }
+
     /*
      * SelectVersion() has several responsibilities:
      *
@@ -284,12 +289,16 @@ JLI_Launch(int argc, char ** argv,              /* main argc, argv */
      *     the pre 1.9 JRE [ 1.6 thru 1.8 ], it is as if 1.9+ has been
      *     invoked from the command line.
      */
+    JLI_StartupBegin("SelectVersion");
     SelectVersion(argc, argv, &main_class);
+    JLI_StartupEnd("SelectVersion");
 
+    JLI_StartupBegin("CreateExecutionEnvironment");
     CreateExecutionEnvironment(&argc, &argv,
                                jrepath, sizeof(jrepath),
                                jvmpath, sizeof(jvmpath),
                                jvmcfg,  sizeof(jvmcfg));
+    JLI_StartupEnd("CreateExecutionEnvironment");
 
     ifn.CreateJavaVM = 0;
     ifn.GetDefaultJavaVMInitArgs = 0;
@@ -298,9 +307,11 @@ JLI_Launch(int argc, char ** argv,              /* main argc, argv */
         start = CurrentTimeMicros();
     }
 
+    JLI_StartupBegin("LoadJavaVM");
     if (!LoadJavaVM(jvmpath, &ifn)) {
         return(6);
     }
+    JLI_StartupEnd("LoadJavaVM");
 
     if (JLI_IsTraceLauncher()) {
         end   = CurrentTimeMicros();
@@ -328,9 +339,11 @@ JLI_Launch(int argc, char ** argv,              /* main argc, argv */
     /* Parse command line options; if the return value of
      * ParseArguments is false, the program should exit.
      */
+    JLI_StartupBegin("ParseArguments");
     if (!ParseArguments(&argc, &argv, &mode, &what, &ret, jrepath)) {
         return(ret);
     }
+    JLI_StartupEnd("ParseArguments");
 
     /* Override class path if -jar flag was specified */
     if (mode == LM_JAR) {
@@ -418,10 +431,12 @@ JavaMain(void* _args)
 
     /* Initialize the virtual machine */
     start = CurrentTimeMicros();
+    JLI_StartupBegin("InitializeJVM");
     if (!InitializeJVM(&vm, &env, &ifn)) {
         JLI_ReportErrorMessage(JVM_ERROR1);
         exit(1);
     }
+    JLI_StartupEnd("InitializeJVM");
 
     if (showSettings != NULL) {
         ShowSettings(env, showSettings);
@@ -511,7 +526,9 @@ JavaMain(void* _args)
      * This method also correctly handles launching existing JavaFX
      * applications that may or may not have a Main-Class manifest entry.
      */
+    JLI_StartupBegin("LoadMainClass");
     mainClass = LoadMainClass(env, mode, what);
+    JLI_StartupEnd("LoadMainClass");
     CHECK_EXCEPTION_NULL_LEAVE(mainClass);
     /*
      * In some cases when launching an application that needs a helper, e.g., a
@@ -558,6 +575,7 @@ JavaMain(void* _args)
     int mainType = (*env)->CallStaticIntMethod(env, helperClass, getMainType);
     CHECK_EXCEPTION_LEAVE(mainType);
 
+    JLI_StartupBegin("main");
     switch (mainType) {
     case 0: {
         mainID = (*env)->GetStaticMethodID(env, mainClass, "main",
@@ -596,6 +614,7 @@ JavaMain(void* _args)
         break;
         }
     }
+    JLI_StartupEnd("main");
 
     /*
      * The launcher's exit code (in the absence of calls to
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 1998, 2020, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 1998, 2026, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -189,6 +189,13 @@ int JVMInit(InvocationFunctions* ifn, jlong threadStackSize,
  */
 void InitLauncher(jboolean javaw);
 
+/*
+ * Hands the invocation to a resident zygote process if one is configured
+ * and reachable. Returns JNI_TRUE, with the exit status in *pret, if the
+ * zygote ran the program, or JNI_FALSE to launch the VM as usual.
+ */
+jboolean ZygoteLaunch(const char *lname, int argc, char **argv, int *pret);
+
 /*
  * For MacOSX and Windows/Unix compatibility we require these
  * entry points, some of them may be stubbed out on Windows/Unixes.
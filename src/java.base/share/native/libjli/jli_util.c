@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2005, 2018, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2005, 2026, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -29,6 +29,18 @@
 #include "jni.h"
 #include "jli_util.h"
 
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <stdint.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+#if defined(__linux__)
+#include <sys/syscall.h>
+#endif
+#endif
+
 /*
  * Returns a pointer to a block of at least 'size' bytes of memory.
  * Prints error message and exits if the memory could not be allocated.
@@ -131,6 +143,142 @@ JLI_StrCCmp(const char *s1, const char* s2)
    return JLI_StrNCmp(s1, s2, JLI_StrLen(s2));
 }
 
+/*
+ * Startup timeline recorder.  Writers claim a slot with one atomic
+ * increment and never block; once the ring is full the oldest records
+ * are overwritten and counted as dropped.  Recording is set up by the
+ * first event, which the launcher records before it starts any thread.
+ */
+#define STARTUP_RING_SIZE 1024
+
+typedef struct {
+    const char *phase;
+    jlong       nanos;
+    jlong       tid;
+    jboolean    begin;
+} StartupRecord;
+
+static StartupRecord _startup_ring[STARTUP_RING_SIZE];
+static volatile jint _startup_next = 0;
+static int _startup_state = 0;          /* 0 unknown, 1 on, -1 off */
+static char *_startup_file = NULL;
+static jlong _startup_origin = 0;
+
+static jlong
+StartupNanos()
+{
+#ifdef _WIN32
+    static LARGE_INTEGER freq;
+    LARGE_INTEGER count;
+    if (freq.QuadPart == 0 && !QueryPerformanceFrequency(&freq)) {
+        return 0;
+    }
+    QueryPerformanceCounter(&count);
+    return (jlong) ((double) count.QuadPart * 1e9 / (double) freq.QuadPart);
+#else
+    struct timespec ts;
+    if (clock_gettime(CLOCK_MONOTONIC, &ts) != 0) {
+        return 0;
+    }
+    return (jlong) ts.tv_sec * 1000000000 + ts.tv_nsec;
+#endif
+}
+
+static jlong
+StartupThreadId()
+{
+#if defined(_WIN32)
+    return (jlong) GetCurrentThreadId();
+#elif defined(__linux__)
+    return (jlong) syscall(SYS_gettid);
+#else
+    return (jlong) (intptr_t) pthread_self();
+#endif
+}
+
+static jint
+StartupClaimSlot()
+{
+#ifdef _WIN32
+    return (jint) InterlockedIncrement((LONG volatile *) &_startup_next) - 1;
+#else
+    return __atomic_fetch_add(&_startup_next, 1, __ATOMIC_RELAXED);
+#endif
+}
+
+static void
+StartupDump()
+{
+    jint next = _startup_next;
+    jint count = (next < STARTUP_RING_SIZE) ? next : STARTUP_RING_SIZE;
+    jint first = next - count;
+    const char *sep = "";
+    FILE *fp;
+    jint i;
+#ifdef _WIN32
+    long pid = (long) GetCurrentProcessId();
+#else
+    long pid = (long) getpid();
+#endif
+
+    fp = fopen(_startup_file, "w");
+    if (fp == NULL) {
+        JLI_TraceLauncher("cannot write startup trace to %s\n",
+                          _startup_file);
+        return;
+    }
+    fprintf(fp, "{\"traceEvents\":[");
+    for (i = first; i < next; i++) {
+        StartupRecord *r = &_startup_ring[i % STARTUP_RING_SIZE];
+        if (r->phase == NULL) {
+            continue;
+        }
+        fprintf(fp, "%s\n{\"name\":\"%s\",\"ph\":\"%c\",\"ts\":%.3f,"
+                    "\"pid\":%ld,\"tid\":%lld}",
+                sep, r->phase, r->begin ? 'B' : 'E',
+                (double) (r->nanos - _startup_origin) / 1000.0,
+                pid, (long long) r->tid);
+        sep = ",";
+    }
+    fprintf(fp, "\n],\"displayTimeUnit\":\"ms\","
+                "\"otherData\":{\"dropped\":%ld}}\n",
+            (long) first);
+    fclose(fp);
+}
+
+static jboolean
+StartupInit()
+{
+    char *file = getenv(JLI_STARTUP_TRACE_ENV_ENTRY);
+    if (file == NULL || *file == '\0') {
+        _startup_state = -1;
+        return JNI_FALSE;
+    }
+    _startup_file = JLI_StringDup(file);
+    _startup_origin = StartupNanos();
+    _startup_state = 1;
+    atexit(StartupDump);
+    return JNI_TRUE;
+}
+
+JNIEXPORT void JNICALL
+JLI_StartupEvent(const char *phase, jboolean begin)
+{
+    StartupRecord *r;
+    jint slot;
+
+    if (_startup_state <= 0 && (_startup_state < 0 || !StartupInit())) {
+        return;
+    }
+
+    slot = StartupClaimSlot();
+    r = &_startup_ring[slot % STARTUP_RING_SIZE];
+    r->nanos = StartupNanos();
+    r->tid = StartupThreadId();
+    r->begin = begin;
+    r->phase = phase;
+}
+
 JNIEXPORT JLI_List JNICALL
 JLI_List_new(size_t capacity)
 {
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2005, 2020, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2005, 2026, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -122,6 +122,21 @@ JLI_SetTraceLauncher();
 
 jboolean JLI_IsTraceLauncher();
 
+/*
+ * Startup timeline.  When JDK_JAVA_STARTUP_TRACE names a file, the begin
+ * and end of each startup phase are recorded with a monotonic timestamp
+ * in a fixed ring, and written to that file in Chrome trace event format
+ * when the process exits.  Phase names must be string literals.  Other
+ * native libraries reach the recorder through JNU_StartupEvent.
+ */
+#define JLI_STARTUP_TRACE_ENV_ENTRY "JDK_JAVA_STARTUP_TRACE"
+
+JNIEXPORT void JNICALL
+JLI_StartupEvent(const char *phase, jboolean begin);
+
+#define JLI_StartupBegin(phase) JLI_StartupEvent((phase), JNI_TRUE)
+#define JLI_StartupEnd(phase)   JLI_StartupEvent((phase), JNI_FALSE)
+
 /*
  * JLI_List - a dynamic list of char*
  */
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2003, 2022, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2003, 2026, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -574,8 +574,8 @@ parse_nv_pair(char **lp, char **name, char **value)
  *   -2 Error accessing the manifest from within the jarfile (most likely
  *      a manifest is not present, or this isn't a valid zip/jar file).
  */
-int
-JLI_ParseManifest(char *jarfile, manifest_info *info)
+static int
+ParseManifest(char *jarfile, manifest_info *info)
 {
     int     fd;
     zentry  entry;
@@ -631,6 +631,17 @@ JLI_ParseManifest(char *jarfile, manifest_info *info)
         return (-2);
 }
 
+int
+JLI_ParseManifest(char *jarfile, manifest_info *info)
+{
+    int rc;
+
+    JLI_StartupBegin("ParseManifest");
+    rc = ParseManifest(jarfile, info);
+    JLI_StartupEnd("ParseManifest");
+    return rc;
+}
+
 /*
  * Opens the jar file and unpacks the specified file from its contents.
  * Returns NULL on failure.
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2005, 2018, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2005, 2026, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -315,10 +315,12 @@ JLI_WildcardExpandClasspath(const char *classpath)
 
     if (JLI_StrChr(classpath, '*') == NULL)
         return classpath;
+    JLI_StartupBegin("WildcardExpandClasspath");
     fl = JLI_List_split(classpath, PATH_SEPARATOR);
     expanded = FileList_expandWildcards(fl) ?
         JLI_List_join(fl, PATH_SEPARATOR) : classpath;
     JLI_List_free(fl);
+    JLI_StartupEnd("WildcardExpandClasspath");
     if (getenv(JLDEBUG_ENV_ENTRY) != 0)
         printf("Expanded wildcards:\n"
                "    before: \"%s\"\n"
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 1995, 2023, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 1995, 2026, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -777,12 +777,14 @@ ZIP_Open_Generic(const char *name, char **pmsg, int mode, jlong lastModified)
         *pmsg = NULL;
     }
 
+    JNU_StartupEvent("ZIP_Open", JNI_TRUE);
     zip = ZIP_Get_From_Cache(name, pmsg, lastModified);
 
     if (zip == NULL && pmsg != NULL && *pmsg == NULL) {
         ZFILE zfd = ZFILE_Open(name, mode);
         zip = ZIP_Put_In_Cache(name, zfd, pmsg, lastModified);
     }
+    JNU_StartupEvent("ZIP_Open", JNI_FALSE);
     return zip;
 }
 
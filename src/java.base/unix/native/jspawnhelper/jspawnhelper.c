@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2013, 2023, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2013, 2026, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -30,8 +30,13 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <unistd.h>
+#include <string.h>
 #include <sys/types.h>
 #include <sys/stat.h>
+#ifdef __linux__
+#include <sys/socket.h>
+#include <sys/syscall.h>
+#endif
 
 #include "childproc.h"
 
@@ -72,10 +77,12 @@ void shutItDown() {
  * - the SpawnInfo struct
  * - the data strings for fields in ChildStuff
  */
+static void initVectors (int fdout, ChildStuff *c, const SpawnInfo *sp, char *buf);
+
 void initChildStuff (int fdin, int fdout, ChildStuff *c) {
     char *buf;
     SpawnInfo sp;
-    int bufsize, offset=0;
+    int bufsize;
     int magic;
     int res;
 
@@ -97,7 +104,7 @@ void initChildStuff (int fdin, int fdout, ChildStuff *c) {
     }
 
     bufsize = sp.argvBytes + sp.envvBytes +
-              sp.dirlen + sp.parentPathvBytes;
+              sp.dirlen + sp.parentPathvBytes + sp.execPathlen;
 
     ALLOC(buf, bufsize);
 
@@ -105,34 +112,224 @@ void initChildStuff (int fdin, int fdout, ChildStuff *c) {
         error (fdout, ERR_PIPE);
     }
 
+    initVectors (fdout, c, &sp, buf);
+}
+
+/*
+ * point the fields of ChildStuff, and parentPathv, into the data strings
+ */
+static void initVectors (int fdout, ChildStuff *c, const SpawnInfo *sp, char *buf) {
+    int offset=0;
+
     /* Initialize argv[] */
-    ALLOC(c->argv, sizeof(char *) * sp.nargv);
-    initVectorFromBlock (c->argv, buf+offset, sp.nargv-1);
-    offset += sp.argvBytes;
+    ALLOC(c->argv, sizeof(char *) * sp->nargv);
+    initVectorFromBlock (c->argv, buf+offset, sp->nargv-1);
+    offset += sp->argvBytes;
 
     /* Initialize envv[] */
-    if (sp.nenvv == 0) {
+    if (sp->nenvv == 0) {
         c->envv = 0;
     } else {
-        ALLOC(c->envv, sizeof(char *) * sp.nenvv);
-        initVectorFromBlock (c->envv, buf+offset, sp.nenvv-1);
-        offset += sp.envvBytes;
+        ALLOC(c->envv, sizeof(char *) * sp->nenvv);
+        initVectorFromBlock (c->envv, buf+offset, sp->nenvv-1);
+        offset += sp->envvBytes;
     }
 
     /* Initialize pdir */
-    if (sp.dirlen == 0) {
+    if (sp->dirlen == 0) {
         c->pdir = 0;
     } else {
         c->pdir = buf+offset;
-        offset += sp.dirlen;
+        offset += sp->dirlen;
     }
 
     /* Initialize parentPathv[] */
-    ALLOC(parentPathv, sizeof (char *) * sp.nparentPathv)
-    initVectorFromBlock ((const char**)parentPathv, buf+offset, sp.nparentPathv-1);
-    offset += sp.parentPathvBytes;
+    ALLOC(parentPathv, sizeof (char *) * sp->nparentPathv)
+    initVectorFromBlock ((const char**)parentPathv, buf+offset, sp->nparentPathv-1);
+    offset += sp->parentPathvBytes;
+
+    /* Initialize execPath */
+    if (sp->execPathlen == 0) {
+        c->execPath = 0;
+    } else {
+        c->execPath = buf+offset;
+        offset += sp->execPathlen;
+    }
+}
+
+#ifdef __linux__
+/*
+ * Create the child as a sibling of this process, so that it is a child
+ * of the JVM which can wait for it. Like fork(), the child runs on a copy
+ * of our (small) address space.
+ */
+static pid_t cloneSibling () {
+#if defined(__s390__) || defined(__s390x__)
+    return (pid_t) syscall (SYS_clone, 0, CLONE_PARENT | SIGCHLD, 0, 0, 0);
+#else
+    return (pid_t) syscall (SYS_clone, CLONE_PARENT | SIGCHLD, 0, 0, 0, 0);
+#endif
 }
 
+/*
+ * read a SpawnRequest together with the descriptors passed with it
+ * returns 1 on success, 0 on end of file, -1 on error
+ */
+static int readRequest (int sock, SpawnRequest *req, int fds[], int *nfds) {
+    struct msghdr msg;
+    struct iovec iov;
+    struct cmsghdr *cmsg;
+    union {
+        struct cmsghdr align;
+        char buf[CMSG_SPACE(sizeof(int) * SPAWN_MAX_FDS)];
+    } control;
+    ssize_t n;
+
+    *nfds = 0;
+    memset (&msg, 0, sizeof(msg));
+    iov.iov_base = req;
+    iov.iov_len = sizeof(*req);
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    msg.msg_control = control.buf;
+    msg.msg_controllen = sizeof(control.buf);
+
+    RESTARTABLE(recvmsg (sock, &msg, MSG_CMSG_CLOEXEC), n);
+    if (n <= 0) {
+        return (int) n;
+    }
+    for (cmsg = CMSG_FIRSTHDR(&msg); cmsg != NULL; cmsg = CMSG_NXTHDR(&msg, cmsg)) {
+        if (cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SCM_RIGHTS) {
+            int count = (cmsg->cmsg_len - CMSG_LEN(0)) / sizeof(int);
+            if (*nfds + count > SPAWN_MAX_FDS) {
+                return -1;
+            }
+            memcpy (fds + *nfds, CMSG_DATA(cmsg), count * sizeof(int));
+            *nfds += count;
+        }
+    }
+    if ((msg.msg_flags & MSG_CTRUNC) != 0) {
+        return -1;
+    }
+    /* the rest of a request split by the stream */
+    if (n < (ssize_t) sizeof(*req) &&
+        readFully (sock, (char *)req + n, sizeof(*req) - n) != (ssize_t) (sizeof(*req) - n)) {
+        return -1;
+    }
+    return 1;
+}
+
+/*
+ * give the passed descriptors their places in ChildStuff
+ */
+static int assignDescriptors (ChildStuff *c, int fdmask, const int fds[], int nfds) {
+    int *slots[SPAWN_MAX_FDS] = {
+        &c->in[0], &c->out[1], &c->err[1], &c->fail[1],
+        &c->fds[0], &c->fds[1], &c->fds[2]
+    };
+    int i, n = 0;
+
+    c->in[0] = c->in[1] = c->out[0] = c->out[1] = -1;
+    c->err[0] = c->err[1] = c->fail[0] = c->fail[1] = -1;
+    c->childenv[0] = c->childenv[1] = -1;
+    c->fds[0] = c->fds[1] = c->fds[2] = -1;
+    for (i = 0; i < SPAWN_MAX_FDS; i++) {
+        if ((fdmask & (1 << i)) != 0) {
+            if (n == nfds) {
+                return -1;
+            }
+            *slots[i] = fds[n++];
+        }
+    }
+    return (n == nfds && c->fail[1] != -1) ? 0 : -1;
+}
+
+/*
+ * Serve spawn requests on the socket until the JVM closes it.
+ * We exit on any protocol error; the JVM then starts a new server
+ * or falls back to spawning a helper per child.
+ */
+static void serveSpawnRequests (int sock) {
+    for (;;) {
+        SpawnRequest req;
+        SpawnReply reply;
+        SpawnInfo sp;
+        ChildStuff c;
+        int fds[SPAWN_MAX_FDS];
+        int nfds, i, r;
+        char *buf;
+
+        r = readRequest (sock, &req, fds, &nfds);
+        if (r == 0) {
+            exit (0);
+        }
+        if (r < 0 || req.magic != magicNumber() ||
+            readFully (sock, &c, sizeof(c)) != sizeof(c) ||
+            readFully (sock, &sp, sizeof(sp)) != sizeof(sp) ||
+            req.bufsize != sp.argvBytes + sp.envvBytes +
+                           sp.dirlen + sp.parentPathvBytes + sp.execPathlen) {
+            exit (ERR_PIPE);
+        }
+        buf = malloc (req.bufsize);
+        if (buf == NULL) {
+            exit (ERR_MALLOC);
+        }
+        if (readFully (sock, buf, req.bufsize) != req.bufsize) {
+            exit (ERR_PIPE);
+        }
+        initVectors (-1, &c, &sp, buf);
+
+        if (assignDescriptors (&c, req.fdmask, fds, nfds) == 0) {
+            reply.pid = cloneSibling ();
+            if (reply.pid == 0) {
+                childProcess (&c);
+            }
+            reply.errnum = (reply.pid < 0) ? errno : 0;
+        } else {
+            reply.pid = -1;
+            reply.errnum = EINVAL;
+        }
+
+        /* the child has its own copies now */
+        for (i = 0; i < nfds; i++) {
+            close (fds[i]);
+        }
+        free (c.argv);
+        free (c.envv);
+        free ((void *)parentPathv);
+        parentPathv = NULL;
+        free (buf);
+
+        if (writeFully (sock, &reply, sizeof(reply)) != sizeof(reply)) {
+            exit (ERR_PIPE);
+        }
+    }
+}
+
+/*
+ * argv[1] is SPAWN_SERVER_ARG followed by the socket fd, which the
+ * JVM placed at FAIL_FILENO
+ */
+static void spawnServer (const char *arg) {
+    struct stat buf;
+    int sock;
+
+    if (sscanf (arg + strlen(SPAWN_SERVER_ARG), "%d", &sock) != 1 ||
+        sock != FAIL_FILENO || fstat(sock, &buf) != 0 || !S_ISSOCK(buf.st_mode)) {
+        shutItDown();
+    }
+    /* drop whatever else we inherited */
+    if (closeDescriptors() == 0) {
+        int max_fd = (int)sysconf(_SC_OPEN_MAX);
+        int fd;
+        for (fd = FAIL_FILENO + 1; fd < max_fd; fd++) {
+            close(fd);
+        }
+    }
+    serveSpawnRequests (sock);
+}
+#endif /* __linux__ */
+
 int main(int argc, char *argv[]) {
     ChildStuff c;
     struct stat buf;
@@ -142,6 +339,15 @@ int main(int argc, char *argv[]) {
 
 #ifdef DEBUG
     jtregSimulateCrash(0, 4);
+#endif
+#ifdef __linux__
+    if (argc > 1 && strncmp (argv[1], SPAWN_SERVER_ARG, strlen(SPAWN_SERVER_ARG)) == 0) {
+        // Reset any mask signals from parent
+        sigemptyset(&unblock_signals);
+        sigprocmask(SIG_SETMASK, &unblock_signals, NULL);
+        spawnServer (argv[1]);
+        return 0; /* NOT REACHED */
+    }
 #endif
     r = sscanf (argv[1], "%d:%d:%d", &fdinr, &fdinw, &fdout);
     if (r == 3 && fcntl(fdinr, F_GETFD) != -1 && fcntl(fdinw, F_GETFD) != -1) {
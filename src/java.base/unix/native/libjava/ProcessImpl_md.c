@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 1995, 2023, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 1995, 2026, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -46,6 +46,16 @@
 
 #include <spawn.h>
 
+#include <limits.h>
+#include <pthread.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+#ifdef __linux__
+#include <sys/socket.h>
+#endif
+
 #include "childproc.h"
 
 /*
@@ -111,6 +121,15 @@
  * This is a JDK-specific implementation detail which just happens to be
  * implemented for jdk.lang.Process.launchMechanism=POSIX_SPAWN.
  *
+ * With jdk.lang.Process.launchMechanism=SPAWN_SERVER, the first exec is only
+ * paid once: a single jspawnhelper is started on first use and kept running.
+ * It receives the same data as in POSIX_SPAWN mode, together with the child's
+ * file descriptors, over a Unix domain socket, and forks off each child from
+ * its own small address space. On Linux the child is created with
+ * clone(CLONE_PARENT), so it is a child of the JVM and is waited for as in
+ * the other modes. Where no spawn server can be used, this mode behaves like
+ * POSIX_SPAWN.
+ *
  * --- Linux-specific ---
  *
  * How does glibc implement posix_spawn?
@@ -275,6 +294,115 @@ effectivePathv(JNIEnv *env)
     return pathv;
 }
 
+/*
+ * Cache of programs found in PATH, so that the child can exec the
+ * program directly rather than trying every PATH entry. The PATH searched
+ * is always parentPathv, which never changes, so the program name is the
+ * key. Entries expire, so that a program installed in an earlier PATH
+ * entry is found after at most RESOLVED_EXEC_TTL seconds. A program that
+ * moved is looked up again by the child.
+ */
+#define RESOLVED_EXEC_ENTRIES 64
+#define RESOLVED_EXEC_TTL 5
+
+typedef struct {
+    char *file;
+    char *path;
+    time_t expires;
+} ResolvedExec;
+
+static ResolvedExec resolvedExecs[RESOLVED_EXEC_ENTRIES];
+static int resolvedExecNext = 0;
+static pthread_mutex_t resolvedExecLock = PTHREAD_MUTEX_INITIALIZER;
+
+static time_t
+monotonicSeconds(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec;
+}
+
+/* Searches parentPathv like execvp() would, for a regular file we may
+ * execute. Returns a malloc'ed path, or NULL.
+ */
+static char*
+searchPath(const char *file)
+{
+    char expanded_file[PATH_MAX];
+    int filelen = strlen(file);
+    const char * const * dirs;
+    struct stat sb;
+
+    for (dirs = parentPathv; *dirs; dirs++) {
+        const char * dir = *dirs;
+        int dirlen = strlen(dir);
+        if (filelen + dirlen + 2 >= PATH_MAX) {
+            continue;
+        }
+        memcpy(expanded_file, dir, dirlen);
+        if (expanded_file[dirlen - 1] != '/')
+            expanded_file[dirlen++] = '/';
+        memcpy(expanded_file + dirlen, file, filelen);
+        expanded_file[dirlen + filelen] = '\0';
+        if (stat(expanded_file, &sb) == 0 && S_ISREG(sb.st_mode) &&
+            access(expanded_file, X_OK) == 0) {
+            return strdup(expanded_file);
+        }
+    }
+    return NULL;
+}
+
+/* Returns the malloc'ed path of the program the child will exec for
+ * file, or NULL if the child should search PATH itself.
+ */
+static const char*
+resolveExecutable(const char *file)
+{
+    time_t now;
+    char *path = NULL;
+    int i;
+
+    if (parentPathv == NULL || *file == '\0' || strchr(file, '/') != NULL) {
+        return NULL;
+    }
+    now = monotonicSeconds();
+    pthread_mutex_lock(&resolvedExecLock);
+    for (i = 0; i < RESOLVED_EXEC_ENTRIES; i++) {
+        ResolvedExec *e = &resolvedExecs[i];
+        if (e->file != NULL && e->expires > now && strcmp(e->file, file) == 0) {
+            path = strdup(e->path);
+            break;
+        }
+    }
+    pthread_mutex_unlock(&resolvedExecLock);
+    if (path != NULL) {
+        return path;
+    }
+
+    path = searchPath(file);
+    if (path != NULL) {
+        char *filecopy = strdup(file);
+        char *pathcopy = strdup(path);
+        if (filecopy != NULL && pathcopy != NULL) {
+            ResolvedExec *e;
+            pthread_mutex_lock(&resolvedExecLock);
+            e = &resolvedExecs[resolvedExecNext];
+            resolvedExecNext = (resolvedExecNext + 1) % RESOLVED_EXEC_ENTRIES;
+            free(e->file);
+            free(e->path);
+            e->file = filecopy;
+            e->path = pathcopy;
+            e->expires = now + RESOLVED_EXEC_TTL;
+            pthread_mutex_unlock(&resolvedExecLock);
+        } else {
+            free(filecopy);
+            free(pathcopy);
+        }
+    }
+    return path;
+}
+
 JNIEXPORT void JNICALL
 Java_java_lang_ProcessImpl_init(JNIEnv *env, jclass clazz)
 {
@@ -434,6 +562,39 @@ static int copystrings(char *buf, int offset, const char * const *arg) {
     return offset+count;
 }
 
+/* Fills in the sizes of the data strings sent to jspawnhelper,
+ * and returns their total number of bytes.
+ */
+static int initSpawnInfo(const ChildStuff *c, const char * const *envv, SpawnInfo *sp) {
+    int bufsize;
+    arraysize(c->argv, &sp->nargv, &sp->argvBytes);
+    bufsize = sp->argvBytes;
+    arraysize(envv, &sp->nenvv, &sp->envvBytes);
+    bufsize += sp->envvBytes;
+    sp->dirlen = c->pdir == 0 ? 0 : strlen(c->pdir)+1;
+    bufsize += sp->dirlen;
+    arraysize(parentPathv, &sp->nparentPathv, &sp->parentPathvBytes);
+    bufsize += sp->parentPathvBytes;
+    sp->execPathlen = c->execPath == 0 ? 0 : strlen(c->execPath)+1;
+    bufsize += sp->execPathlen;
+    return bufsize;
+}
+
+/* Copies the data strings sent to jspawnhelper into buf.
+ */
+static void copySpawnData(char *buf, int bufsize, const ChildStuff *c,
+                          const char * const *envv, const SpawnInfo *sp) {
+    int offset;
+    offset = copystrings(buf, 0, &c->argv[0]);
+    offset = copystrings(buf, offset, envv);
+    memcpy(buf+offset, c->pdir, sp->dirlen);
+    offset += sp->dirlen;
+    offset = copystrings(buf, offset, parentPathv);
+    memcpy(buf+offset, c->execPath, sp->execPathlen);
+    offset += sp->execPathlen;
+    assert(offset == bufsize);
+}
+
 /**
  * We are unusually paranoid; use of vfork is
  * especially likely to tickle gcc/glibc bugs.
@@ -486,7 +647,7 @@ forkChild(ChildStuff *c) {
 static pid_t
 spawnChild(JNIEnv *env, jobject process, ChildStuff *c, const char *helperpath) {
     pid_t resultPid;
-    int i, offset, rval, bufsize, magic;
+    int i, rval, bufsize, magic;
     char *buf, buf1[(3 * 11) + 3]; // "%d:%d:%d\0"
     char *hlpargs[3];
     SpawnInfo sp;
@@ -514,16 +675,10 @@ spawnChild(JNIEnv *env, jobject process, ChildStuff *c, const char *helperpath)
      * - the home directory string
      * - the parentPath string
      * - the parentPathv array
+     * - the resolved executable path string
      */
     /* First calculate the sizes */
-    arraysize(c->argv, &sp.nargv, &sp.argvBytes);
-    bufsize = sp.argvBytes;
-    arraysize(c->envv, &sp.nenvv, &sp.envvBytes);
-    bufsize += sp.envvBytes;
-    sp.dirlen = c->pdir == 0 ? 0 : strlen(c->pdir)+1;
-    bufsize += sp.dirlen;
-    arraysize(parentPathv, &sp.nparentPathv, &sp.parentPathvBytes);
-    bufsize += sp.parentPathvBytes;
+    bufsize = initSpawnInfo(c, c->envv, &sp);
     /* We need to clear FD_CLOEXEC if set in the fds[].
      * Files are created FD_CLOEXEC in Java.
      * Otherwise, they will be closed when the target gets exec'd */
@@ -551,12 +706,7 @@ spawnChild(JNIEnv *env, jobject process, ChildStuff *c, const char *helperpath)
     if (buf == 0) {
         return -1;
     }
-    offset = copystrings(buf, 0, &c->argv[0]);
-    offset = copystrings(buf, offset, &c->envv[0]);
-    memcpy(buf+offset, c->pdir, sp.dirlen);
-    offset += sp.dirlen;
-    offset = copystrings(buf, offset, parentPathv);
-    assert(offset == bufsize);
+    copySpawnData(buf, bufsize, c, c->envv, &sp);
 
     magic = magicNumber();
 
@@ -586,6 +736,193 @@ spawnChild(JNIEnv *env, jobject process, ChildStuff *c, const char *helperpath)
     return resultPid;
 }
 
+#ifdef __linux__
+/* The spawn server, started on first use. Requests are serialized by the
+ * lock; spawnServerDisabled is set when the server cannot create children.
+ */
+static pthread_mutex_t spawnServerLock = PTHREAD_MUTEX_INITIALIZER;
+static int spawnServerFd = -1;
+static pid_t spawnServerPid = -1;
+static int spawnServerDisabled = 0;
+
+static int
+startSpawnServer(const char *helperpath) {
+    int sv[2], fd, rval;
+    pid_t pid;
+    char arg[sizeof(SPAWN_SERVER_ARG) + 11];
+    char *hlpargs[3];
+    posix_spawn_file_actions_t actions;
+
+    if (socketpair(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0, sv) != 0) {
+        return -1;
+    }
+    /* The server finds its end at FAIL_FILENO. dup2() to the same
+     * descriptor would not clear FD_CLOEXEC, so move it out of the way. */
+    fd = sv[1];
+    if (fd == FAIL_FILENO) {
+        fd = fcntl(sv[1], F_DUPFD_CLOEXEC, FAIL_FILENO + 1);
+    }
+    snprintf(arg, sizeof(arg), "%s%d", SPAWN_SERVER_ARG, FAIL_FILENO);
+    hlpargs[0] = (char*)helperpath;
+    hlpargs[1] = arg;
+    hlpargs[2] = NULL;
+
+    rval = -1;
+    if (fd != -1 && posix_spawn_file_actions_init(&actions) == 0) {
+        rval = posix_spawn_file_actions_adddup2(&actions, fd, FAIL_FILENO);
+        if (rval == 0) {
+            rval = posix_spawn(&pid, helperpath, &actions, 0,
+                               (char * const *) hlpargs, environ);
+        }
+        posix_spawn_file_actions_destroy(&actions);
+    }
+    if (fd != sv[1]) {
+        closeSafely(fd);
+    }
+    close(sv[1]);
+    if (rval != 0) {
+        close(sv[0]);
+        return -1;
+    }
+    spawnServerFd = sv[0];
+    spawnServerPid = pid;
+    return 0;
+}
+
+static void
+stopSpawnServer(void) {
+    close(spawnServerFd);
+    spawnServerFd = -1;
+    kill(spawnServerPid, SIGKILL);
+    waitpid(spawnServerPid, NULL, 0);
+    spawnServerPid = -1;
+}
+
+/* Sends the request with the child's descriptors, followed by the
+ * ChildStuff and SpawnInfo structs and the data strings.
+ */
+static int
+sendSpawnRequest(const ChildStuff *c, const SpawnInfo *sp, const char *buf, int bufsize) {
+    const int fds[SPAWN_MAX_FDS] = {
+        c->in[0], c->out[1], c->err[1], c->fail[1],
+        c->fds[0], c->fds[1], c->fds[2]
+    };
+    int passed[SPAWN_MAX_FDS];
+    union {
+        struct cmsghdr align;
+        char buf[CMSG_SPACE(sizeof(int) * SPAWN_MAX_FDS)];
+    } control;
+    SpawnRequest req;
+    struct msghdr msg;
+    struct iovec iov;
+    struct cmsghdr *cmsg;
+    int i, nfds = 0;
+    ssize_t n;
+
+    req.magic = magicNumber();
+    req.fdmask = 0;
+    req.bufsize = bufsize;
+    for (i = 0; i < SPAWN_MAX_FDS; i++) {
+        if (fds[i] != -1) {
+            req.fdmask |= 1 << i;
+            passed[nfds++] = fds[i];
+        }
+    }
+
+    memset(&msg, 0, sizeof(msg));
+    memset(&control, 0, sizeof(control));
+    iov.iov_base = &req;
+    iov.iov_len = sizeof(req);
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    msg.msg_control = control.buf;
+    msg.msg_controllen = CMSG_SPACE(sizeof(int) * nfds);
+    cmsg = CMSG_FIRSTHDR(&msg);
+    cmsg->cmsg_level = SOL_SOCKET;
+    cmsg->cmsg_type = SCM_RIGHTS;
+    cmsg->cmsg_len = CMSG_LEN(sizeof(int) * nfds);
+    memcpy(CMSG_DATA(cmsg), passed, sizeof(int) * nfds);
+
+    RESTARTABLE(sendmsg(spawnServerFd, &msg, MSG_NOSIGNAL), n);
+    if (n <= 0) {
+        return -1;
+    }
+    if (n < (ssize_t) sizeof(req) &&
+        writeFully(spawnServerFd, (char *)&req + n, sizeof(req) - n) != (ssize_t) (sizeof(req) - n)) {
+        return -1;
+    }
+    if (writeFully(spawnServerFd, c, sizeof(*c)) != sizeof(*c) ||
+        writeFully(spawnServerFd, sp, sizeof(*sp)) != sizeof(*sp) ||
+        writeFully(spawnServerFd, buf, bufsize) != bufsize) {
+        return -1;
+    }
+    return 0;
+}
+
+/* Asks the spawn server to start the child, starting the server first
+ * if needed. Returns the pid of the child, or -1 if the server could not
+ * be used.
+ */
+static pid_t
+requestSpawn(ChildStuff *c, const char *helperpath) {
+    SpawnInfo sp;
+    SpawnReply reply;
+    const char * const *envv;
+    char *buf;
+    int bufsize, attempt;
+
+    /* The server's environment is a snapshot; send the current one */
+    envv = (c->envv != NULL) ? c->envv : (const char * const *) environ;
+    bufsize = initSpawnInfo(c, envv, &sp);
+    buf = malloc(bufsize);
+    if (buf == NULL) {
+        return -1;
+    }
+    copySpawnData(buf, bufsize, c, envv, &sp);
+
+    reply.pid = -1;
+    reply.errnum = 0;
+    pthread_mutex_lock(&spawnServerLock);
+    /* A server that died since the last request is restarted once */
+    for (attempt = 0; attempt < 2 && !spawnServerDisabled; attempt++) {
+        if (spawnServerFd == -1 && startSpawnServer(helperpath) != 0) {
+            break;
+        }
+        if (sendSpawnRequest(c, &sp, buf, bufsize) == 0 &&
+            readFully(spawnServerFd, &reply, sizeof(reply)) == sizeof(reply)) {
+            break;
+        }
+        reply.pid = -1;
+        stopSpawnServer();
+    }
+    if (reply.pid < 0 && (reply.errnum == EINVAL || reply.errnum == EPERM)) {
+        /* clone(CLONE_PARENT) is not supported here, e.g. the JVM is the
+         * init process of a pid namespace */
+        spawnServerDisabled = 1;
+        stopSpawnServer();
+    }
+    pthread_mutex_unlock(&spawnServerLock);
+    free(buf);
+    return reply.pid;
+}
+#endif /* __linux__ */
+
+/* Start the child through the spawn server, or in MODE_POSIX_SPAWN
+ * if that fails.
+ */
+static pid_t
+serverSpawnChild(JNIEnv *env, jobject process, ChildStuff *c, const char *helperpath) {
+#ifdef __linux__
+    pid_t resultPid = requestSpawn(c, helperpath);
+    if (resultPid > 0) {
+        return resultPid;
+    }
+#endif
+    c->mode = MODE_POSIX_SPAWN;
+    c->sendAlivePing = 1;
+    return spawnChild(env, process, c, helperpath);
+}
+
 /*
  * Start a child process running function childProcess.
  * This function only returns in the parent.
@@ -602,6 +939,8 @@ startChild(JNIEnv *env, jobject process, ChildStuff *c, const char *helperpath)
         return forkChild(c);
       case MODE_POSIX_SPAWN:
         return spawnChild(env, process, c, helperpath);
+      case MODE_SPAWN_SERVER:
+        return serverSpawnChild(env, process, c, helperpath);
       default:
         return -1;
     }
@@ -638,6 +977,7 @@ Java_java_lang_ProcessImpl_forkAndExec(JNIEnv *env,
     c->argv = NULL;
     c->envv = NULL;
     c->pdir = NULL;
+    c->execPath = NULL;
 
     /* Convert prog + argBlock into a char ** argv.
      * Add one word room for expansion of argv for use by
@@ -652,6 +992,7 @@ Java_java_lang_ProcessImpl_forkAndExec(JNIEnv *env,
     c->argv[0] = pprog;
     c->argc = argc + 2;
     initVectorFromBlock(c->argv+1, pargBlock, argc);
+    c->execPath = resolveExecutable(pprog);
 
     if (envBlock != NULL) {
         /* Convert envBlock into a char ** envv */
@@ -784,6 +1125,7 @@ Java_java_lang_ProcessImpl_forkAndExec(JNIEnv *env,
 
     free(c->argv);
     free(c->envv);
+    free((void *)c->execPath);
     free(c);
 
     if (fds != NULL)
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 1999, 2023, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 1999, 2026, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -35,6 +35,8 @@
 #include <string.h>
 #include <dirent.h>
 #include <unistd.h>
+#include <fcntl.h>
+#include <stdint.h>
 
 #include "jvm.h"
 #include "TimeZone_md.h"
@@ -257,6 +259,404 @@ isFileIdentical(char *buf, size_t size, char *pathname)
     return possibleMatch;
 }
 
+/*
+ * Content index of the zoneinfo tree.
+ *
+ * Finding the zone of a copied /etc/localtime means comparing it with
+ * every file under ZONEINFO_DIR. To avoid doing that on every start, the
+ * first scan hashes every file and records the hashes, in scan order, in
+ * a per-user cache file:
+ *
+ *     #zoneinfo-index 1 <ZONEINFO_DIR>
+ *     D <inode> <mtime sec> <mtime nsec> <directory>
+ *     F <size> <64-bit FNV-1a hash> <zone ID>
+ *
+ * There is one D line per scanned directory. The index is only trusted
+ * if none of those directories has changed. A candidate with the right
+ * hash is always compared byte for byte, so a hash collision costs one
+ * extra read and a rescan, and never yields a wrong zone. Because
+ * entries are kept in scan order, the first verified hit is the zone
+ * findZoneinfoFile would have returned.
+ */
+#define ZONEINDEX_MAGIC         "#zoneinfo-index 1 "
+#define ZONEINDEX_DIR_NAME      "java"
+#define ZONEINDEX_FILE_NAME     "zoneinfo.idx"
+#define ZONEINDEX_MAX_SIZE      (4 * 1024 * 1024)
+
+#if defined(MACOSX)
+#define MTIME_NSEC(st)  ((st).st_mtimespec.tv_nsec)
+#else
+#define MTIME_NSEC(st)  ((st).st_mtim.tv_nsec)
+#endif
+
+static uint64_t
+hashZoneData(const char *buf, size_t size)
+{
+    uint64_t h = 0xcbf29ce484222325ULL;
+    size_t i;
+
+    for (i = 0; i < size; i++) {
+        h ^= (unsigned char) buf[i];
+        h *= 0x100000001b3ULL;
+    }
+    return h;
+}
+
+/*
+ * Returns the path name of the per-user index file, creating its
+ * directory if needed, or NULL if there is no usable cache directory.
+ */
+static char *
+getZoneIndexPath()
+{
+    const char *base = getenv("XDG_CACHE_HOME");
+    char *cacheDir = NULL;
+    char *dir;
+    char *path;
+
+    if (base == NULL || *base != '/') {
+        const char *home = getenv("HOME");
+        if (home == NULL || *home != '/') {
+            return NULL;
+        }
+        cacheDir = getPathName(home, ".cache");
+        if (cacheDir == NULL) {
+            return NULL;
+        }
+        (void) mkdir(cacheDir, 0700);
+        base = cacheDir;
+    }
+    dir = getPathName(base, ZONEINDEX_DIR_NAME);
+    free((void *) cacheDir);
+    if (dir == NULL) {
+        return NULL;
+    }
+    if (mkdir(dir, 0700) == -1 && errno != EEXIST) {
+        free((void *) dir);
+        return NULL;
+    }
+    path = getPathName(dir, ZONEINDEX_FILE_NAME);
+    free((void *) dir);
+    return path;
+}
+
+/*
+ * Returns 1 if 'pathname' is a regular file with exactly the data in buf.
+ */
+static int
+isSameZoneData(const char *buf, size_t size, const char *pathname)
+{
+    struct stat64 statbuf;
+    char *dbuf;
+    int fd;
+    int res;
+    int same = 0;
+
+    RESTARTABLE(open(pathname, O_RDONLY), fd);
+    if (fd == -1) {
+        return 0;
+    }
+    RESTARTABLE(fstat64(fd, &statbuf), res);
+    if (res == 0 && S_ISREG(statbuf.st_mode) &&
+        (size_t)statbuf.st_size == size &&
+        (dbuf = (char *) malloc(size > 0 ? size : 1)) != NULL) {
+        RESTARTABLE(read(fd, dbuf, size), res);
+        same = (res == (ssize_t) size && memcmp(buf, dbuf, size) == 0);
+        free((void *) dbuf);
+    }
+    (void) close(fd);
+    return same;
+}
+
+/*
+ * Looks up the data in buf in the index text 'index'. Returns 1 and
+ * stores a zone ID, or NULL if no zoneinfo file has that content, in
+ * *tzp if the index is valid. Returns 0 if the index is stale or
+ * malformed. The index text is modified.
+ */
+static int
+lookupZoneIndex(char *index, const char *buf, size_t size, char **tzp)
+{
+    uint64_t hash = hashZoneData(buf, size);
+    size_t magicLen = strlen(ZONEINDEX_MAGIC);
+    char *line, *next, *lines;
+
+    *tzp = NULL;
+    if (strncmp(index, ZONEINDEX_MAGIC, magicLen) != 0) {
+        return 0;
+    }
+    line = index + magicLen;
+    next = strchr(line, '\n');
+    if (next == NULL) {
+        return 0;
+    }
+    *next++ = '\0';
+    if (strcmp(line, ZONEINFO_DIR) != 0) {
+        return 0;
+    }
+    lines = next;
+
+    /* First make sure that no directory has changed since the scan */
+    for (line = lines; *line != '\0'; line = next) {
+        next = strchr(line, '\n');
+        if (next == NULL) {
+            return 0;
+        }
+        *next++ = '\0';
+        if (line[0] == 'D') {
+            unsigned long long ino;
+            long long sec;
+            long nsec;
+            int pos = 0;
+            struct stat64 statbuf;
+            int res;
+
+            if (sscanf(line, "D %llu %lld %ld %n", &ino, &sec, &nsec, &pos) != 3
+                || pos == 0) {
+                return 0;
+            }
+            RESTARTABLE(stat64(line + pos, &statbuf), res);
+            if (res == -1 || !S_ISDIR(statbuf.st_mode) ||
+                (unsigned long long) statbuf.st_ino != ino ||
+                (long long) statbuf.st_mtime != sec ||
+                (long) MTIME_NSEC(statbuf) != nsec) {
+                return 0;
+            }
+        } else if (line[0] != 'F') {
+            return 0;
+        }
+    }
+
+    /* Lines are now NUL separated */
+    for (line = lines; *line != '\0'; line += strlen(line) + 1) {
+        unsigned long long fsize;
+        unsigned long long fhash;
+        int pos = 0;
+
+        if (line[0] != 'F') {
+            continue;
+        }
+        if (sscanf(line, "F %llu %llx %n", &fsize, &fhash, &pos) != 2
+            || pos == 0) {
+            return 0;
+        }
+        if ((size_t) fsize == size && (uint64_t) fhash == hash) {
+            char *pathname = getPathName(ZONEINFO_DIR, line + pos);
+            int same;
+            if (pathname == NULL) {
+                return 0;
+            }
+            same = isSameZoneData(buf, size, pathname);
+            free((void *) pathname);
+            if (!same) {
+                /* most likely rewritten in place, so rescan */
+                return 0;
+            }
+            *tzp = strdup(line + pos);
+            return *tzp != NULL;
+        }
+    }
+    return 1;
+}
+
+/*
+ * Reads the index file at 'indexPath' into a NUL terminated buffer.
+ */
+static char *
+readZoneIndex(const char *indexPath)
+{
+    struct stat64 statbuf;
+    char *index = NULL;
+    int fd;
+    int res;
+
+    RESTARTABLE(open(indexPath, O_RDONLY | O_NOFOLLOW), fd);
+    if (fd == -1) {
+        return NULL;
+    }
+    RESTARTABLE(fstat64(fd, &statbuf), res);
+    if (res == 0 && S_ISREG(statbuf.st_mode) &&
+        statbuf.st_uid == geteuid() &&
+        statbuf.st_size > 0 && statbuf.st_size <= ZONEINDEX_MAX_SIZE &&
+        (index = (char *) malloc((size_t) statbuf.st_size + 1)) != NULL) {
+        RESTARTABLE(read(fd, index, (size_t) statbuf.st_size), res);
+        if (res != (ssize_t) statbuf.st_size) {
+            free((void *) index);
+            index = NULL;
+        } else {
+            index[statbuf.st_size] = '\0';
+        }
+    }
+    (void) close(fd);
+    return index;
+}
+
+/*
+ * Scans 'dir' like findZoneinfoFile, but hashes every zoneinfo file and
+ * writes the index lines to 'out'. The first zone ID whose file matches
+ * buf is stored in *tzp. Returns 0 if the scan could not be completed.
+ */
+static int
+indexZoneinfoDir(FILE *out, const char *buf, size_t size,
+                 const char *dir, char **tzp)
+{
+    struct stat64 statbuf;
+    DIR *dirp;
+    struct dirent *dp;
+    int ok = 1;
+    int res;
+
+    RESTARTABLE(stat64(dir, &statbuf), res);
+    if (res == -1) {
+        return 0;
+    }
+    fprintf(out, "D %llu %lld %ld %s\n",
+            (unsigned long long) statbuf.st_ino,
+            (long long) statbuf.st_mtime, (long) MTIME_NSEC(statbuf), dir);
+
+    dirp = opendir(dir);
+    if (dirp == NULL) {
+        return 0;
+    }
+    while (ok && (dp = readdir(dirp)) != NULL) {
+        char *pathname;
+        char *zone;
+
+        /* Skip the same entries as findZoneinfoFile */
+        if (dp->d_name[0] == '.'
+            || (strcmp(dp->d_name, "ROC") == 0)
+            || (strcmp(dp->d_name, "posixrules") == 0)
+            || (strcmp(dp->d_name, "localtime") == 0)) {
+            continue;
+        }
+        pathname = getPathName(dir, dp->d_name);
+        if (pathname == NULL) {
+            ok = 0;
+            break;
+        }
+        RESTARTABLE(stat64(pathname, &statbuf), res);
+        if (res == -1) {
+            /* findZoneinfoFile ignores these as well */
+        } else if (S_ISDIR(statbuf.st_mode)) {
+            ok = indexZoneinfoDir(out, buf, size, pathname, tzp);
+        } else if (S_ISREG(statbuf.st_mode) &&
+                   (zone = getZoneName(pathname)) != NULL &&
+                   statbuf.st_size <= ZONEINDEX_MAX_SIZE) {
+            size_t fsize = (size_t) statbuf.st_size;
+            char *dbuf = (char *) malloc(fsize > 0 ? fsize : 1);
+            int fd;
+
+            if (dbuf == NULL) {
+                ok = 0;
+            } else {
+                RESTARTABLE(open(pathname, O_RDONLY), fd);
+                if (fd != -1) {
+                    RESTARTABLE(read(fd, dbuf, fsize), res);
+                    if (res == (ssize_t) fsize) {
+                        fprintf(out, "F %llu %016llx %s\n",
+                                (unsigned long long) fsize,
+                                (unsigned long long) hashZoneData(dbuf, fsize),
+                                zone);
+                        if (*tzp == NULL && fsize == size &&
+                            memcmp(buf, dbuf, size) == 0) {
+                            *tzp = strdup(zone);
+                        }
+                    }
+                    (void) close(fd);
+                }
+                free((void *) dbuf);
+            }
+        }
+        free((void *) pathname);
+    }
+    (void) closedir(dirp);
+    return ok;
+}
+
+/*
+ * Scans the zoneinfo tree for the data in buf and rewrites the index
+ * at 'indexPath'. Returns the zone ID or NULL.
+ */
+static char *
+rebuildZoneIndex(const char *indexPath, const char *buf, size_t size)
+{
+    char *tmpPath;
+    char *tz = NULL;
+    FILE *out;
+    int fd;
+    int ok;
+
+    tmpPath = (char *) malloc(strlen(indexPath) + 32);
+    if (tmpPath == NULL) {
+        return findZoneinfoFile((char *) buf, size, ZONEINFO_DIR);
+    }
+    snprintf(tmpPath, strlen(indexPath) + 32, "%s.%ld.tmp",
+             indexPath, (long) getpid());
+    RESTARTABLE(open(tmpPath, O_WRONLY | O_CREAT | O_EXCL | O_NOFOLLOW, 0600),
+                fd);
+    if (fd == -1 || (out = fdopen(fd, "w")) == NULL) {
+        if (fd != -1) {
+            (void) close(fd);
+            (void) unlink(tmpPath);
+        }
+        free((void *) tmpPath);
+        return findZoneinfoFile((char *) buf, size, ZONEINFO_DIR);
+    }
+
+    fprintf(out, "%s%s\n", ZONEINDEX_MAGIC, ZONEINFO_DIR);
+    ok = indexZoneinfoDir(out, buf, size, ZONEINFO_DIR, &tz);
+    if (fclose(out) != 0) {
+        ok = 0;
+    }
+    if (!ok || rename(tmpPath, indexPath) == -1) {
+        (void) unlink(tmpPath);
+    }
+    free((void *) tmpPath);
+    return tz;
+}
+
+/*
+ * Finds the zone ID of the zoneinfo file with the data in buf, using
+ * the index of the zoneinfo tree when possible.
+ */
+static char *
+findZoneinfoFileIndexed(char *buf, size_t size)
+{
+    char *indexPath;
+    char *index;
+    char *tz = NULL;
+
+    /* The popular zones are cheaper to check than reading the index */
+    for (unsigned int i = 0; i < sizeof (popularZones) / sizeof (popularZones[0]); i++) {
+        char *pathname = getPathName(ZONEINFO_DIR, popularZones[i]);
+        if (pathname == NULL) {
+            continue;
+        }
+        tz = isFileIdentical(buf, size, pathname);
+        free((void *) pathname);
+        if (tz != NULL) {
+            return tz;
+        }
+    }
+
+    indexPath = getZoneIndexPath();
+    if (indexPath == NULL) {
+        return findZoneinfoFile(buf, size, ZONEINFO_DIR);
+    }
+    index = readZoneIndex(indexPath);
+    if (index != NULL) {
+        int valid = lookupZoneIndex(index, buf, size, &tz);
+        free((void *) index);
+        if (valid) {
+            free((void *) indexPath);
+            return tz;
+        }
+    }
+    tz = rebuildZoneIndex(indexPath, buf, size);
+    free((void *) indexPath);
+    return tz;
+}
+
 /*
  * Performs Linux specific mapping and returns a zone ID
  * if found. Otherwise, NULL is returned.
@@ -363,7 +763,7 @@ getPlatformTimeZoneID()
     }
     (void) close(fd);
 
-    tz = findZoneinfoFile(buf, size, ZONEINFO_DIR);
+    tz = findZoneinfoFileIndexed(buf, size);
     free((void *) buf);
     return tz;
 }
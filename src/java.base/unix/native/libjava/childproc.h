@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2013, 2023, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2013, 2026, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -85,6 +85,7 @@ extern char **environ;
 #define MODE_FORK 1
 #define MODE_POSIX_SPAWN 2
 #define MODE_VFORK 3
+#define MODE_SPAWN_SERVER 4
 
 typedef struct _ChildStuff
 {
@@ -101,6 +102,7 @@ typedef struct _ChildStuff
     const char *pdir;
     int redirectErrorStream;
     int sendAlivePing;
+    const char *execPath; /* argv[0] as found in PATH by the parent, or NULL */
 } ChildStuff;
 
 /* following used in addition when mode is SPAWN */
@@ -112,6 +114,7 @@ typedef struct _SpawnInfo {
     int dirlen; /* length of home directory string */
     int nparentPathv; /* number of elements in parentPathv array */
     int parentPathvBytes; /* total number of bytes in parentPathv array */
+    int execPathlen; /* length of resolved executable path string */
 } SpawnInfo;
 
 /* If ChildStuff.sendAlivePing is true, child shall signal aliveness to
@@ -121,6 +124,37 @@ typedef struct _SpawnInfo {
  * our platforms. */
 #define CHILD_IS_ALIVE      65535
 
+/* In MODE_SPAWN_SERVER, a long-lived jspawnhelper started with
+ * "SPAWN_SERVER_ARG<fd>" receives spawn requests on the socket fd.
+ * Each request is a SpawnRequest, followed by the ChildStuff struct,
+ * the SpawnInfo struct and the data strings as in MODE_POSIX_SPAWN.
+ * The descriptors for the child are passed with the SpawnRequest as
+ * SCM_RIGHTS, in the order of the SPAWN_FD_* bits set in fdmask.
+ * The server answers with a SpawnReply. The child is created as a
+ * sibling of the server, so it is a child of the JVM like in the
+ * other modes, and exec failures are reported on the fail pipe. */
+#define SPAWN_SERVER_ARG    "spawnserver:"
+
+#define SPAWN_FD_IN         0x01    /* in[0] */
+#define SPAWN_FD_OUT        0x02    /* out[1] */
+#define SPAWN_FD_ERR        0x04    /* err[1] */
+#define SPAWN_FD_FAIL       0x08    /* fail[1] */
+#define SPAWN_FD_STDIN      0x10    /* fds[0] */
+#define SPAWN_FD_STDOUT     0x20    /* fds[1] */
+#define SPAWN_FD_STDERR     0x40    /* fds[2] */
+#define SPAWN_MAX_FDS       7
+
+typedef struct _SpawnRequest {
+    int magic;      /* magicNumber() */
+    int fdmask;     /* the descriptors passed */
+    int bufsize;    /* number of bytes of data strings */
+} SpawnRequest;
+
+typedef struct _SpawnReply {
+    pid_t pid;      /* the child, or -1 */
+    int errnum;     /* errno value if the child could not be created */
+} SpawnReply;
+
 /**
  * The cached and split version of the JDK's effective PATH.
  * (We don't support putenv("PATH=...") in native code)
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2008, 2023, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2008, 2026, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -57,6 +57,11 @@ void* getProcessHandle() {
     return procHandle;
 }
 
+void* findStartupEventFunction() {
+    /* libjli is loaded by the launcher, not by the VM or this library */
+    return dlsym(RTLD_DEFAULT, "JLI_StartupEvent");
+}
+
 void buildJniFunctionName(const char *sym, const char *cname,
                           char *jniEntryName) {
     strcpy(jniEntryName, sym);
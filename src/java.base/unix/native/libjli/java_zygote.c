@@ -0,0 +1,351 @@
+/*
+ * Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+/*
+ * Client side of the launcher zygote mode.
+ *
+ * When JDK_JAVA_ZYGOTE names a Unix domain socket, the launcher hands
+ * the whole invocation to the resident process listening on it, instead
+ * of creating a VM itself. The request is one message, carrying the
+ * launcher's stdin, stdout and stderr as SCM_RIGHTS ancillary data:
+ *
+ *     jint    magic                ZYGOTE_MAGIC
+ *     jint    length               of everything that follows
+ *     jint    argc
+ *     jint    envc
+ *     char[]  launcher name, cwd, argv[0..argc-1], env[0..envc-1]
+ *             each NUL terminated
+ *
+ * The zygote answers with 5 byte frames, a tag byte followed by a jint:
+ *
+ *     'A' pid     the request was accepted and is run by process pid
+ *     'D' 0       the request was declined
+ *     'X' status  the program exited with the given status
+ *
+ * While the program runs, the launcher forwards SIGINT, SIGTERM and
+ * SIGHUP as 'S' signo frames. If the socket cannot be reached, or the
+ * zygote declines or goes away before accepting, the launcher creates
+ * the VM as usual. All values are in host byte order; both ends are
+ * always on the same machine.
+ */
+
+#include <errno.h>
+#include <poll.h>
+#include <signal.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/types.h>
+#include <sys/un.h>
+
+#include "java.h"
+
+#define ZYGOTE_ENV_VAR          "JDK_JAVA_ZYGOTE"
+#define ZYGOTE_MAGIC            0x4A5A5931      /* "JZY1" */
+#define ZYGOTE_MAX_REQUEST      (16 * 1024 * 1024)
+
+#define ZYGOTE_ACCEPTED         'A'
+#define ZYGOTE_DECLINED         'D'
+#define ZYGOTE_EXITED           'X'
+#define ZYGOTE_SIGNAL           'S'
+
+extern char **environ;
+
+static volatile sig_atomic_t pendingSignal = 0;
+
+static void
+ZygoteSignalHandler(int sig)
+{
+    pendingSignal = sig;
+}
+
+/*
+ * Connects to the zygote socket and checks that it is served by a
+ * process of the same user. Returns the socket or -1.
+ */
+static int
+ZygoteConnect(const char *path)
+{
+    struct sockaddr_un addr;
+    uid_t peerUid;
+    int fd;
+
+    if (JLI_StrLen(path) >= sizeof(addr.sun_path)) {
+        JLI_TraceLauncher("zygote socket path too long: %s\n", path);
+        return -1;
+    }
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    JLI_StrCpy(addr.sun_path, path);
+
+    fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd == -1) {
+        return -1;
+    }
+    if (connect(fd, (struct sockaddr *) &addr, sizeof(addr)) == -1) {
+        JLI_TraceLauncher("zygote not available at %s: %s\n",
+                          path, strerror(errno));
+        close(fd);
+        return -1;
+    }
+
+#if defined(__linux__)
+    {
+        struct ucred cred;
+        socklen_t len = sizeof(cred);
+        if (getsockopt(fd, SOL_SOCKET, SO_PEERCRED, &cred, &len) == -1) {
+            close(fd);
+            return -1;
+        }
+        peerUid = cred.uid;
+    }
+#else
+    {
+        gid_t peerGid;
+        if (getpeereid(fd, &peerUid, &peerGid) == -1) {
+            close(fd);
+            return -1;
+        }
+    }
+#endif
+    if (peerUid != geteuid()) {
+        JLI_TraceLauncher("zygote at %s belongs to another user\n", path);
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+/*
+ * Appends a NUL terminated string to the request buffer.
+ */
+static char *
+PutString(char *p, const char *s)
+{
+    size_t len = JLI_StrLen(s) + 1;
+    memcpy(p, s, len);
+    return p + len;
+}
+
+/*
+ * Builds the request and sends it together with the stdio descriptors.
+ */
+static jboolean
+ZygoteSendRequest(int fd, const char *lname, int argc, char **argv)
+{
+    char cwd[MAXPATHLEN];
+    size_t size;
+    jint header[4];
+    jint envc = 0;
+    char *request;
+    char *p;
+    ssize_t n;
+    size_t sent;
+    int i;
+
+    struct msghdr msg;
+    struct iovec iov;
+    struct cmsghdr *cmsg;
+    union {
+        struct cmsghdr hdr;
+        char buf[CMSG_SPACE(sizeof(int) * 3)];
+    } control;
+    int fds[3] = { 0, 1, 2 };
+
+    if (getcwd(cwd, sizeof(cwd)) == NULL) {
+        return JNI_FALSE;
+    }
+
+    size = sizeof(header) + JLI_StrLen(lname) + 1 + JLI_StrLen(cwd) + 1;
+    for (i = 0; i < argc; i++) {
+        size += JLI_StrLen(argv[i]) + 1;
+    }
+    for (envc = 0; environ[envc] != NULL; envc++) {
+        size += JLI_StrLen(environ[envc]) + 1;
+    }
+    if (size > ZYGOTE_MAX_REQUEST) {
+        return JNI_FALSE;
+    }
+
+    request = (char *) JLI_MemAlloc(size);
+    header[0] = ZYGOTE_MAGIC;
+    header[1] = (jint) (size - 2 * sizeof(jint));
+    header[2] = argc;
+    header[3] = envc;
+    memcpy(request, header, sizeof(header));
+    p = request + sizeof(header);
+    p = PutString(p, lname);
+    p = PutString(p, cwd);
+    for (i = 0; i < argc; i++) {
+        p = PutString(p, argv[i]);
+    }
+    for (i = 0; i < envc; i++) {
+        p = PutString(p, environ[i]);
+    }
+
+    /* The descriptors travel with the first chunk */
+    memset(&msg, 0, sizeof(msg));
+    memset(&control, 0, sizeof(control));
+    iov.iov_base = request;
+    iov.iov_len = size;
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    msg.msg_control = control.buf;
+    msg.msg_controllen = sizeof(control.buf);
+    cmsg = CMSG_FIRSTHDR(&msg);
+    cmsg->cmsg_level = SOL_SOCKET;
+    cmsg->cmsg_type = SCM_RIGHTS;
+    cmsg->cmsg_len = CMSG_LEN(sizeof(fds));
+    memcpy(CMSG_DATA(cmsg), fds, sizeof(fds));
+
+    do {
+        n = sendmsg(fd, &msg, 0);
+    } while (n == -1 && errno == EINTR);
+    sent = (n > 0) ? (size_t) n : 0;
+    while (n != -1 && sent < size) {
+        n = write(fd, request + sent, size - sent);
+        if (n > 0) {
+            sent += (size_t) n;
+        } else if (n == -1 && errno == EINTR) {
+            n = 0;
+        }
+    }
+    JLI_MemFree(request);
+    return (sent == size) ? JNI_TRUE : JNI_FALSE;
+}
+
+/*
+ * Reads one reply frame, forwarding any signal received in the meantime.
+ * Returns JNI_FALSE on EOF or error.
+ */
+static jboolean
+ZygoteReadFrame(int fd, char *tag, jint *value)
+{
+    char frame[1 + sizeof(jint)];
+    size_t got = 0;
+
+    while (got < sizeof(frame)) {
+        struct pollfd pfd;
+        ssize_t n;
+
+        if (pendingSignal != 0) {
+            char sig[1 + sizeof(jint)];
+            jint signo = (jint) pendingSignal;
+            pendingSignal = 0;
+            sig[0] = ZYGOTE_SIGNAL;
+            memcpy(sig + 1, &signo, sizeof(jint));
+            /* best effort; the exit status tells the rest */
+            if (write(fd, sig, sizeof(sig)) == -1) {
+                JLI_TraceLauncher("cannot forward signal %d to zygote\n",
+                                  (int) signo);
+            }
+        }
+        pfd.fd = fd;
+        pfd.events = POLLIN;
+        pfd.revents = 0;
+        if (poll(&pfd, 1, -1) == -1) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return JNI_FALSE;
+        }
+        n = read(fd, frame + got, sizeof(frame) - got);
+        if (n == 0) {
+            return JNI_FALSE;
+        } else if (n == -1) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return JNI_FALSE;
+        }
+        got += (size_t) n;
+    }
+    *tag = frame[0];
+    memcpy(value, frame + 1, sizeof(jint));
+    return JNI_TRUE;
+}
+
+jboolean
+ZygoteLaunch(const char *lname, int argc, char **argv, int *pret)
+{
+    const char *path = getenv(ZYGOTE_ENV_VAR);
+    struct sigaction sa, oldInt, oldTerm, oldHup;
+    jboolean accepted = JNI_FALSE;
+    jboolean handled = JNI_FALSE;
+    char tag;
+    jint value;
+    int fd;
+
+    if (path == NULL || *path == '\0') {
+        return JNI_FALSE;
+    }
+    fd = ZygoteConnect(path);
+    if (fd == -1) {
+        return JNI_FALSE;
+    }
+    if (!ZygoteSendRequest(fd, lname, argc, argv)) {
+        JLI_TraceLauncher("cannot send request to zygote at %s\n", path);
+        close(fd);
+        return JNI_FALSE;
+    }
+
+    memset(&sa, 0, sizeof(sa));
+    sa.sa_handler = ZygoteSignalHandler;
+    sigemptyset(&sa.sa_mask);
+    sigaction(SIGINT, &sa, &oldInt);
+    sigaction(SIGTERM, &sa, &oldTerm);
+    sigaction(SIGHUP, &sa, &oldHup);
+
+    while (ZygoteReadFrame(fd, &tag, &value)) {
+        if (tag == ZYGOTE_ACCEPTED) {
+            JLI_TraceLauncher("zygote runs the program as pid %d\n",
+                              (int) value);
+            accepted = JNI_TRUE;
+        } else if (tag == ZYGOTE_DECLINED) {
+            JLI_TraceLauncher("zygote declined the request\n");
+            break;
+        } else if (tag == ZYGOTE_EXITED && accepted) {
+            *pret = (int) value;
+            handled = JNI_TRUE;
+            break;
+        }
+    }
+
+    sigaction(SIGINT, &oldInt, NULL);
+    sigaction(SIGTERM, &oldTerm, NULL);
+    sigaction(SIGHUP, &oldHup, NULL);
+    close(fd);
+
+    if (accepted && !handled) {
+        /* The program may have run in part, so it cannot be rerun */
+        JLI_ReportErrorMessage("Error: lost connection to the zygote at %s",
+                               path);
+        *pret = 1;
+        handled = JNI_TRUE;
+    }
+    return handled;
+}
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2008, 2023, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2008, 2026, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -45,10 +45,6 @@
 #include <sys/xattr.h>
 #endif
 
-/* For POSIX-compliant getpwuid_r */
-#include <pwd.h>
-#include <grp.h>
-
 #ifdef __linux__
 #include <sys/syscall.h>
 #endif
@@ -76,6 +72,7 @@
 #include "jlong.h"
 
 #include "sun_nio_fs_UnixNativeDispatcher.h"
+#include "UnixUserCache.h"
 
 #if defined(_AIX)
   #define DIR DIR64
@@ -85,11 +82,6 @@
   #define closedir closedir64
 #endif
 
-/**
- * Size of password or group entry when not available via sysconf
- */
-#define ENT_BUF_SIZE   1024
-
 #define RESTARTABLE(_cmd, _result) do { \
   do { \
     _result = _cmd; \
@@ -1051,191 +1043,139 @@ Java_sun_nio_fs_UnixNativeDispatcher_mknod0(JNIEnv* env, jclass this,
     }
 }
 
-JNIEXPORT jbyteArray JNICALL
-Java_sun_nio_fs_UnixNativeDispatcher_getpwuid(JNIEnv* env, jclass this, jint uid)
+/**
+ * Returns the name as a byte array, or NULL with an exception pending.
+ */
+static jbyteArray nameToByteArray(JNIEnv* env, int err, char* name)
 {
     jbyteArray result = NULL;
-    int buflen;
-    char* pwbuf;
-
-    /* allocate buffer for password record */
-    buflen = (int)sysconf(_SC_GETPW_R_SIZE_MAX);
-    if (buflen == -1)
-        buflen = ENT_BUF_SIZE;
-    pwbuf = (char*)malloc(buflen);
-    if (pwbuf == NULL) {
+    if (err == ENOMEM) {
         JNU_ThrowOutOfMemoryError(env, "native heap");
+    } else if (err != 0) {
+        throwUnixException(env, err);
     } else {
-        struct passwd pwent;
-        struct passwd* p = NULL;
-        int res = 0;
-
-        errno = 0;
-        RESTARTABLE(getpwuid_r((uid_t)uid, &pwent, pwbuf, (size_t)buflen, &p), res);
-
-        if (res != 0 || p == NULL || p->pw_name == NULL || *(p->pw_name) == '\0') {
-            /* not found or error */
-            if (errno == 0)
-                errno = ENOENT;
-            throwUnixException(env, errno);
-        } else {
-            jsize len = strlen(p->pw_name);
-            result = (*env)->NewByteArray(env, len);
-            if (result != NULL) {
-                (*env)->SetByteArrayRegion(env, result, 0, len, (jbyte*)(p->pw_name));
-            }
+        jsize len = strlen(name);
+        result = (*env)->NewByteArray(env, len);
+        if (result != NULL) {
+            (*env)->SetByteArrayRegion(env, result, 0, len, (jbyte*)name);
         }
-        free(pwbuf);
+        free(name);
     }
-
     return result;
 }
 
+JNIEXPORT jbyteArray JNICALL
+Java_sun_nio_fs_UnixNativeDispatcher_getpwuid(JNIEnv* env, jclass this, jint uid)
+{
+    char* name = NULL;
+    int err = userCacheGetName(USER_CACHE_USER, uid, &name);
+    return nameToByteArray(env, err, name);
+}
 
 JNIEXPORT jbyteArray JNICALL
 Java_sun_nio_fs_UnixNativeDispatcher_getgrgid(JNIEnv* env, jclass this, jint gid)
 {
-    jbyteArray result = NULL;
-    int buflen;
-    int retry;
-
-    /* initial size of buffer for group record */
-    buflen = (int)sysconf(_SC_GETGR_R_SIZE_MAX);
-    if (buflen == -1)
-        buflen = ENT_BUF_SIZE;
-
-    do {
-        struct group grent;
-        struct group* g = NULL;
-        int res = 0;
-
-        char* grbuf = (char*)malloc(buflen);
-        if (grbuf == NULL) {
-            JNU_ThrowOutOfMemoryError(env, "native heap");
-            return NULL;
-        }
+    char* name = NULL;
+    int err = userCacheGetName(USER_CACHE_GROUP, gid, &name);
+    return nameToByteArray(env, err, name);
+}
 
-        errno = 0;
-        RESTARTABLE(getgrgid_r((gid_t)gid, &grent, grbuf, (size_t)buflen, &g), res);
-
-        retry = 0;
-        if (res != 0 || g == NULL || g->gr_name == NULL || *(g->gr_name) == '\0') {
-            /* not found or error */
-            if (errno == ERANGE) {
-                /* insufficient buffer size so need larger buffer */
-                buflen += ENT_BUF_SIZE;
-                retry = 1;
-            } else {
-                if (errno == 0)
-                    errno = ENOENT;
-                throwUnixException(env, errno);
+/**
+ * Resolves many user or group ids at once, as needed to list the owners
+ * of the files in a directory. The element for an id without a name is
+ * null.
+ */
+static jobjectArray getNames(JNIEnv* env, int kind, jintArray ids)
+{
+    jsize count = (*env)->GetArrayLength(env, ids);
+    jobjectArray result;
+    jbyteArray name = NULL;
+    jint* idBuf;
+    jclass byteArrayClass;
+    jsize i;
+
+    byteArrayClass = (*env)->FindClass(env, "[B");
+    if (byteArrayClass == NULL) {
+        return NULL;
+    }
+    result = (*env)->NewObjectArray(env, count, byteArrayClass, NULL);
+    if (result == NULL || count == 0) {
+        return result;
+    }
+    idBuf = (jint*)malloc(count * sizeof(jint));
+    if (idBuf == NULL) {
+        JNU_ThrowOutOfMemoryError(env, "native heap");
+        return NULL;
+    }
+    (*env)->GetIntArrayRegion(env, ids, 0, count, idBuf);
+    if ((*env)->ExceptionCheck(env)) {
+        free(idBuf);
+        return NULL;
+    }
+
+    for (i = 0; i < count; i++) {
+        /* files of the same owner tend to be listed together */
+        if (i == 0 || idBuf[i] != idBuf[i - 1]) {
+            char* cname = NULL;
+            int err = userCacheGetName(kind, idBuf[i], &cname);
+            if (name != NULL) {
+                (*env)->DeleteLocalRef(env, name);
             }
-        } else {
-            jsize len = strlen(g->gr_name);
-            result = (*env)->NewByteArray(env, len);
-            if (result != NULL) {
-                (*env)->SetByteArrayRegion(env, result, 0, len, (jbyte*)(g->gr_name));
+            name = (err == 0 || err == ENOMEM) ? nameToByteArray(env, err, cname)
+                                               : NULL;
+            if ((*env)->ExceptionCheck(env)) {
+                result = NULL;
+                break;
             }
         }
+        (*env)->SetObjectArrayElement(env, result, i, name);
+    }
+    free(idBuf);
+    return result;
+}
 
-        free(grbuf);
+JNIEXPORT jobjectArray JNICALL
+Java_sun_nio_fs_UnixNativeDispatcher_getpwuids(JNIEnv* env, jclass this,
+    jintArray uids)
+{
+    return getNames(env, USER_CACHE_USER, uids);
+}
 
-    } while (retry);
+JNIEXPORT jobjectArray JNICALL
+Java_sun_nio_fs_UnixNativeDispatcher_getgrgids(JNIEnv* env, jclass this,
+    jintArray gids)
+{
+    return getNames(env, USER_CACHE_GROUP, gids);
+}
 
-    return result;
+/**
+ * Returns the id for the name, -1 if there is no such name.
+ */
+static jint nameToId(JNIEnv* env, int kind, jlong nameAddress)
+{
+    const char* name = (const char*)jlong_to_ptr(nameAddress);
+    jint id = -1;
+    int err = userCacheGetId(kind, name, &id);
+    if (err == ENOMEM) {
+        JNU_ThrowOutOfMemoryError(env, "native heap");
+    } else if (err != 0 && err != ENOENT) {
+        throwUnixException(env, err);
+    }
+    return (err == 0) ? id : -1;
 }
 
 JNIEXPORT jint JNICALL
 Java_sun_nio_fs_UnixNativeDispatcher_getpwnam0(JNIEnv* env, jclass this,
     jlong nameAddress)
 {
-    jint uid = -1;
-    int buflen;
-    char* pwbuf;
-
-    /* allocate buffer for password record */
-    buflen = (int)sysconf(_SC_GETPW_R_SIZE_MAX);
-    if (buflen == -1)
-        buflen = ENT_BUF_SIZE;
-    pwbuf = (char*)malloc(buflen);
-    if (pwbuf == NULL) {
-        JNU_ThrowOutOfMemoryError(env, "native heap");
-    } else {
-        struct passwd pwent;
-        struct passwd* p = NULL;
-        int res = 0;
-        const char* name = (const char*)jlong_to_ptr(nameAddress);
-
-        errno = 0;
-        RESTARTABLE(getpwnam_r(name, &pwent, pwbuf, (size_t)buflen, &p), res);
-
-        if (res != 0 || p == NULL || p->pw_name == NULL || *(p->pw_name) == '\0') {
-            /* not found or error */
-            if (errno != 0 && errno != ENOENT && errno != ESRCH &&
-                errno != EBADF && errno != EPERM)
-            {
-                throwUnixException(env, errno);
-            }
-        } else {
-            uid = p->pw_uid;
-        }
-        free(pwbuf);
-    }
-
-    return uid;
+    return nameToId(env, USER_CACHE_USER, nameAddress);
 }
 
 JNIEXPORT jint JNICALL
 Java_sun_nio_fs_UnixNativeDispatcher_getgrnam0(JNIEnv* env, jclass this,
     jlong nameAddress)
 {
-    jint gid = -1;
-    int buflen, retry;
-
-    /* initial size of buffer for group record */
-    buflen = (int)sysconf(_SC_GETGR_R_SIZE_MAX);
-    if (buflen == -1)
-        buflen = ENT_BUF_SIZE;
-
-    do {
-        struct group grent;
-        struct group* g = NULL;
-        int res = 0;
-        char *grbuf;
-        const char* name = (const char*)jlong_to_ptr(nameAddress);
-
-        grbuf = (char*)malloc(buflen);
-        if (grbuf == NULL) {
-            JNU_ThrowOutOfMemoryError(env, "native heap");
-            return -1;
-        }
-
-        errno = 0;
-        RESTARTABLE(getgrnam_r(name, &grent, grbuf, (size_t)buflen, &g), res);
-
-        retry = 0;
-        if (res != 0 || g == NULL || g->gr_name == NULL || *(g->gr_name) == '\0') {
-            /* not found or error */
-            if (errno != 0 && errno != ENOENT && errno != ESRCH &&
-                errno != EBADF && errno != EPERM)
-            {
-                if (errno == ERANGE) {
-                    /* insufficient buffer size so need larger buffer */
-                    buflen += ENT_BUF_SIZE;
-                    retry = 1;
-                } else {
-                    throwUnixException(env, errno);
-                }
-            }
-        } else {
-            gid = g->gr_gid;
-        }
-
-        free(grbuf);
-
-    } while (retry);
-
-    return gid;
+    return nameToId(env, USER_CACHE_GROUP, nameAddress);
 }
 
 JNIEXPORT jint JNICALL
@@ -0,0 +1,363 @@
+/*
+ * Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/types.h>
+#include <pwd.h>
+#include <grp.h>
+
+#include "UnixUserCache.h"
+
+/**
+ * Size of password or group entry when not available via sysconf
+ */
+#define ENT_BUF_SIZE        1024
+#define ENT_BUF_MAX_SIZE    (1024 * 1024)
+
+/**
+ * Seconds an entry is kept, and a failed lookup is remembered
+ */
+#define ENTRY_TTL           30
+#define NEGATIVE_ENTRY_TTL  5
+
+#define BUCKET_COUNT        256
+#define MAX_ENTRIES         8192
+
+typedef struct UserCacheEntry {
+    struct UserCacheEntry* next;
+    int kind;
+    int byName;
+    jint id;            /* key, or result if byName */
+    char* name;         /* key if byName, or result (NULL if not found) */
+    int err;            /* 0, or errno value of a failed lookup */
+    int resolving;      /* lookup in progress */
+    time_t expires;
+} UserCacheEntry;
+
+static pthread_mutex_t cacheLock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t cacheResolved = PTHREAD_COND_INITIALIZER;
+static UserCacheEntry* buckets[BUCKET_COUNT];
+static int entryCount = 0;
+
+static time_t now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec;
+}
+
+static unsigned int hashKey(int kind, int byName, jint id, const char* name) {
+    unsigned int h = 2166136261U ^ (unsigned int)(kind * 2 + byName);
+    if (byName) {
+        const unsigned char* p;
+        for (p = (const unsigned char*)name; *p != '\0'; p++) {
+            h = (h ^ *p) * 16777619U;
+        }
+    } else {
+        h = (h ^ (unsigned int)id) * 16777619U;
+    }
+    return (h ^ (h >> 16)) % BUCKET_COUNT;
+}
+
+static UserCacheEntry** findEntry(int kind, int byName, jint id,
+                                  const char* name)
+{
+    UserCacheEntry** prev = &buckets[hashKey(kind, byName, id, name)];
+    UserCacheEntry* e;
+    for (; (e = *prev) != NULL; prev = &e->next) {
+        if (e->kind == kind && e->byName == byName &&
+            (byName ? strcmp(e->name, name) == 0 : e->id == id)) {
+            break;
+        }
+    }
+    return prev;
+}
+
+static void freeEntry(UserCacheEntry* e) {
+    free(e->name);
+    free(e);
+    entryCount--;
+}
+
+/**
+ * Removes entries that are not being looked up, only expired ones
+ * unless 'all' is set.
+ */
+static void purgeEntries(int all) {
+    time_t t = now();
+    int i;
+    for (i = 0; i < BUCKET_COUNT; i++) {
+        UserCacheEntry** prev = &buckets[i];
+        UserCacheEntry* e;
+        while ((e = *prev) != NULL) {
+            if (!e->resolving && (all || e->expires <= t)) {
+                *prev = e->next;
+                freeEntry(e);
+            } else {
+                prev = &e->next;
+            }
+        }
+    }
+}
+
+static UserCacheEntry* newEntry(int kind, int byName, jint id,
+                                const char* name)
+{
+    UserCacheEntry* e;
+    if (entryCount >= MAX_ENTRIES) {
+        purgeEntries(0);
+        if (entryCount >= MAX_ENTRIES) {
+            purgeEntries(1);
+        }
+    }
+    e = (UserCacheEntry*)calloc(1, sizeof(UserCacheEntry));
+    if (e == NULL) {
+        return NULL;
+    }
+    if (byName && (e->name = strdup(name)) == NULL) {
+        free(e);
+        return NULL;
+    }
+    e->kind = kind;
+    e->byName = byName;
+    e->id = id;
+    entryCount++;
+    return e;
+}
+
+static int isNotFound(int err) {
+    return err == 0 || err == ENOENT || err == ESRCH ||
+           err == EBADF || err == EPERM;
+}
+
+/**
+ * Calls the name service. Returns 0 with the name and id of the entry,
+ * or an errno value; ENOENT if there is no such entry.
+ */
+static int resolve(int kind, int byName, jint id, const char* name,
+                   jint* resultId, char** resultName)
+{
+    long buflen = sysconf(kind == USER_CACHE_USER ? _SC_GETPW_R_SIZE_MAX
+                                                  : _SC_GETGR_R_SIZE_MAX);
+    int err;
+
+    if (buflen <= 0) {
+        buflen = ENT_BUF_SIZE;
+    }
+    for (;;) {
+        char* buf = (char*)malloc(buflen);
+        const char* foundName = NULL;
+        jint foundId = -1;
+        int res;
+
+        if (buf == NULL) {
+            return ENOMEM;
+        }
+        errno = 0;
+        if (kind == USER_CACHE_USER) {
+            struct passwd pwent;
+            struct passwd* p = NULL;
+            do {
+                res = byName ? getpwnam_r(name, &pwent, buf, buflen, &p)
+                             : getpwuid_r((uid_t)id, &pwent, buf, buflen, &p);
+            } while (res == EINTR || (res == -1 && errno == EINTR));
+            if (res == 0 && p != NULL) {
+                foundName = p->pw_name;
+                foundId = (jint)p->pw_uid;
+            }
+        } else {
+            struct group grent;
+            struct group* g = NULL;
+            do {
+                res = byName ? getgrnam_r(name, &grent, buf, buflen, &g)
+                             : getgrgid_r((gid_t)id, &grent, buf, buflen, &g);
+            } while (res == EINTR || (res == -1 && errno == EINTR));
+            if (res == 0 && g != NULL) {
+                foundName = g->gr_name;
+                foundId = (jint)g->gr_gid;
+            }
+        }
+
+        if (foundName != NULL && *foundName != '\0') {
+            *resultId = foundId;
+            *resultName = strdup(foundName);
+            free(buf);
+            return (*resultName != NULL) ? 0 : ENOMEM;
+        }
+        free(buf);
+
+        err = (res > 0) ? res : errno;
+        if (err == ERANGE && buflen < ENT_BUF_MAX_SIZE) {
+            /* insufficient buffer size so need larger buffer */
+            buflen *= 2;
+            continue;
+        }
+        return isNotFound(err) ? ENOENT : err;
+    }
+}
+
+/**
+ * Records a result. A failure other than a missing entry is not
+ * remembered, so the entry is removed and the next lookup retries.
+ */
+static void completeEntry(UserCacheEntry* e, int err, jint id, char* name) {
+    e->resolving = 0;
+    e->err = err;
+    if (err == 0) {
+        if (e->byName) {
+            e->id = id;
+            free(name);
+        } else {
+            e->name = name;
+        }
+        e->expires = now() + ENTRY_TTL;
+    } else if (err == ENOENT) {
+        e->expires = now() + NEGATIVE_ENTRY_TTL;
+    } else {
+        UserCacheEntry** prev = findEntry(e->kind, e->byName, e->id, e->name);
+        *prev = e->next;
+        freeEntry(e);
+    }
+    pthread_cond_broadcast(&cacheResolved);
+}
+
+/**
+ * A lookup one way also answers the lookup the other way.
+ */
+static void addReverseEntry(int kind, int byName, jint id, const char* name) {
+    UserCacheEntry** prev = findEntry(kind, !byName, id, name);
+    UserCacheEntry* e = *prev;
+    if (e == NULL) {
+        e = newEntry(kind, !byName, id, name);
+        if (e == NULL) {
+            return;
+        }
+        if (byName) {
+            e->name = strdup(name);
+            if (e->name == NULL) {
+                freeEntry(e);
+                return;
+            }
+        }
+        e->expires = now() + ENTRY_TTL;
+        /* the table may have been purged; look up the bucket again */
+        prev = findEntry(kind, !byName, id, name);
+        e->next = *prev;
+        *prev = e;
+    }
+}
+
+/**
+ * Looks up an entry, waiting for or doing the name service call if it
+ * is not cached. Returns 0 or an errno value.
+ */
+static int lookup(int kind, int byName, jint id, const char* name,
+                  jint* resultId, char** resultName)
+{
+    UserCacheEntry** prev;
+    UserCacheEntry* e;
+    char* foundName = NULL;
+    jint foundId = -1;
+    int err;
+
+    pthread_mutex_lock(&cacheLock);
+    for (;;) {
+        prev = findEntry(kind, byName, id, name);
+        e = *prev;
+        if (e == NULL || (!e->resolving && e->expires <= now())) {
+            break;
+        }
+        if (!e->resolving) {
+            err = e->err;
+            if (err == 0) {
+                *resultId = e->id;
+                *resultName = strdup(e->name);
+                if (*resultName == NULL) {
+                    err = ENOMEM;
+                }
+            }
+            pthread_mutex_unlock(&cacheLock);
+            return err;
+        }
+        pthread_cond_wait(&cacheResolved, &cacheLock);
+    }
+
+    /* Not cached or expired: this thread does the lookup */
+    if (e != NULL) {
+        *prev = e->next;
+        freeEntry(e);
+    }
+    e = newEntry(kind, byName, id, name);
+    if (e != NULL) {
+        e->resolving = 1;
+        prev = findEntry(kind, byName, id, name);
+        e->next = *prev;
+        *prev = e;
+    }
+    pthread_mutex_unlock(&cacheLock);
+
+    err = resolve(kind, byName, id, name, &foundId, &foundName);
+    if (err == 0) {
+        *resultId = foundId;
+        *resultName = strdup(foundName);
+        if (*resultName == NULL) {
+            err = ENOMEM;
+        }
+    }
+
+    pthread_mutex_lock(&cacheLock);
+    if (e != NULL) {
+        if (err == 0) {
+            addReverseEntry(kind, byName, foundId, foundName);
+            if (byName) {
+                completeEntry(e, 0, foundId, NULL);
+            } else {
+                completeEntry(e, 0, foundId, foundName);
+                foundName = NULL;
+            }
+        } else {
+            completeEntry(e, err, -1, NULL);
+        }
+    }
+    pthread_mutex_unlock(&cacheLock);
+    free(foundName);
+    return err;
+}
+
+int userCacheGetName(int kind, jint id, char** name) {
+    jint unused;
+    return lookup(kind, 0, id, NULL, &unused, name);
+}
+
+int userCacheGetId(int kind, const char* name, jint* id) {
+    char* unused = NULL;
+    int err = lookup(kind, 1, -1, name, id, &unused);
+    free(unused);
+    return err;
+}
@@ -0,0 +1,53 @@
+/*
+ * Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+#ifndef UNIX_USER_CACHE_H
+#define UNIX_USER_CACHE_H
+
+#include "jni.h"
+
+/**
+ * Cache of user and group entries looked up through the name service.
+ * Entries are kept for a limited time, so that changes to the user
+ * and group databases are seen eventually. Concurrent lookups of the
+ * same entry wait for a single name service call.
+ */
+
+#define USER_CACHE_USER     0
+#define USER_CACHE_GROUP    1
+
+/**
+ * Looks up the name of a user or group id. Returns 0 and a name that
+ * must be freed by the caller, or an errno value.
+ */
+int userCacheGetName(int kind, jint id, char** name);
+
+/**
+ * Looks up the id of a user or group name. Returns 0 and the id, ENOENT
+ * if there is no such user or group, or another errno value.
+ */
+int userCacheGetId(int kind, const char* name, jint* id);
+
+#endif /* UNIX_USER_CACHE_H */
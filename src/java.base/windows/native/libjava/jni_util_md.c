@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2004, 2023, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2004, 2026, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -35,6 +35,12 @@ void* getProcessHandle() {
     return (void*)GetModuleHandle(NULL);
 }
 
+void* findStartupEventFunction() {
+    /* jli.dll is loaded by the launcher, not by the VM or this library */
+    HMODULE jli = GetModuleHandle("jli.dll");
+    return (jli == NULL) ? NULL : (void*)GetProcAddress(jli, "JLI_StartupEvent");
+}
+
 /*
  * Windows symbols can be simple like JNI_OnLoad or __stdcall format
  * like _JNI_OnLoad@8. We need to handle both.
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2015, 2018, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2015, 2026, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -114,6 +114,25 @@ int osSupport::unmap_memory(void* addr, size_t bytes) {
     return result;
 }
 
+typedef void (JNICALL *StartupEvent_t)(const char *phase, jboolean begin);
+
+/**
+ * Record a startup phase boundary through the launcher, if present.
+ */
+void osSupport::startup_event(const char *phase, bool begin) {
+    static StartupEvent_t startupEvent = NULL;
+    static bool resolved = false;
+    if (!resolved) {
+        HMODULE jli = GetModuleHandle("jli.dll");
+        startupEvent = (jli == NULL) ? NULL :
+            (StartupEvent_t) GetProcAddress(jli, "JLI_StartupEvent");
+        resolved = true;
+    }
+    if (startupEvent != NULL) {
+        (*startupEvent)(phase, begin ? JNI_TRUE : JNI_FALSE);
+    }
+}
+
 /**
  * A CriticalSection to protect a small section of code.
  */
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 1997, 2022, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 1997, 2026, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -813,6 +813,16 @@ jclass FindBootStrapClass(JNIEnv *env, const char *classname)
    return findBootClass(env, classname);
 }
 
+/*
+ * The zygote launch mode relies on Unix domain sockets and descriptor
+ * passing, so it is not supported here.
+ */
+jboolean
+ZygoteLaunch(const char *lname, int argc, char **argv, int *pret)
+{
+    return JNI_FALSE;
+}
+
 void
 InitLauncher(jboolean javaw)
 {
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 1997, 2014, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 1997, 2026, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -25,6 +25,11 @@
 
 #include <string.h>
 
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define ICM_GATHER_AVX2
+#endif
+
 #include "jni.h"
 #include "jni_util.h"
 #include "awt_parseImage.h"
@@ -35,7 +40,8 @@ static int compareLUTs(unsigned int *lut1, int numLut1, int transIdx,
                        unsigned int *lut2, int numLut2, unsigned char *cvtLut,
                        int *retNumLut1, int *retTransIdx, int *jniFlagP);
 
-static int findIdx(unsigned int rgb, unsigned int *lut, int numLut1);
+static void expandICMRow(int *dstP, unsigned char *srcP, int w,
+                         int pixelStride, int *srcLUT);
 
 #define ALPHA_MASK    0xff000000
 #ifndef FALSE
@@ -118,10 +124,10 @@ Java_sun_awt_image_ImageRepresentation_setICMpixels(JNIEnv *env, jclass cls,
     int *dstData;
     jint dstDataLength;
     jint dstDataOff;
-    int *dstP, *dstyP;
-    unsigned char *srcyP, *srcP;
+    int *dstyP;
+    unsigned char *srcyP;
     int *srcLUT = NULL;
-    int yIdx, xIdx;
+    int yIdx;
     int sStride;
     int *cOffs;
     int pixelStride;
@@ -217,11 +223,7 @@ Java_sun_awt_image_ImageRepresentation_setICMpixels(JNIEnv *env, jclass cls,
     dstyP = dstData + dstDataOff + y*sStride + x*pixelStride;
     srcyP = srcData + off;
     for (yIdx = 0; yIdx < h; yIdx++, srcyP += scansize, dstyP+=sStride) {
-        srcP = srcyP;
-        dstP = dstyP;
-        for (xIdx = 0; xIdx < w; xIdx++, dstP+=pixelStride) {
-            *dstP = srcLUT[*srcP++];
-        }
+        expandICMRow(dstyP, srcyP, w, pixelStride, srcLUT);
     }
 
     /* Release the locked arrays */
@@ -375,7 +377,18 @@ Java_sun_awt_image_ImageRepresentation_setDiffICM(JNIEnv *env, jclass cls,
     for (i=0; i < h; i++) {
         dataP = ydataP;
         pixP = ypixP;
-        for (j=0; j < w; j++) {
+        j = 0;
+        if (pixelStride == 1) {
+            for (; j <= w - 4; j += 4) {
+                dataP[0] = cvtLut[pixP[0]];
+                dataP[1] = cvtLut[pixP[1]];
+                dataP[2] = cvtLut[pixP[2]];
+                dataP[3] = cvtLut[pixP[3]];
+                dataP += 4;
+                pixP += 4;
+            }
+        }
+        for (; j < w; j++) {
             *dataP = cvtLut[*pixP];
             dataP += pixelStride;
             pixP++;
@@ -390,6 +403,113 @@ Java_sun_awt_image_ImageRepresentation_setDiffICM(JNIEnv *env, jclass cls,
     return JNI_TRUE;
 }
 
+/*
+ * Expands one row of indexed pixels through the color map.  The common
+ * case of a packed destination is handed to an AVX2 gather when the CPU
+ * supports it, otherwise the lookup is unrolled so that the loads are
+ * independent of each other.
+ */
+#ifdef ICM_GATHER_AVX2
+__attribute__((target("avx2")))
+static int expandICMRowAVX2(int *dstP, unsigned char *srcP, int w,
+                            int *srcLUT)
+{
+    int xIdx = 0;
+
+    for (; xIdx <= w - 8; xIdx += 8) {
+        __m128i idx8 = _mm_loadl_epi64((__m128i *) (srcP + xIdx));
+        __m256i idx = _mm256_cvtepu8_epi32(idx8);
+        __m256i rgb = _mm256_i32gather_epi32(srcLUT, idx, 4);
+        _mm256_storeu_si256((__m256i *) (dstP + xIdx), rgb);
+    }
+    return xIdx;
+}
+
+static int useAVX2Gather(void) {
+    static int supported = -1;
+    if (supported < 0) {
+        __builtin_cpu_init();
+        supported = __builtin_cpu_supports("avx2") ? 1 : 0;
+    }
+    return supported;
+}
+#endif
+
+static void expandICMRow(int *dstP, unsigned char *srcP, int w,
+                         int pixelStride, int *srcLUT)
+{
+    int xIdx = 0;
+
+    if (pixelStride == 1) {
+#ifdef ICM_GATHER_AVX2
+        if (useAVX2Gather()) {
+            xIdx = expandICMRowAVX2(dstP, srcP, w, srcLUT);
+        }
+#endif
+        for (; xIdx <= w - 4; xIdx += 4) {
+            int p0 = srcLUT[srcP[xIdx]];
+            int p1 = srcLUT[srcP[xIdx + 1]];
+            int p2 = srcLUT[srcP[xIdx + 2]];
+            int p3 = srcLUT[srcP[xIdx + 3]];
+            dstP[xIdx] = p0;
+            dstP[xIdx + 1] = p1;
+            dstP[xIdx + 2] = p2;
+            dstP[xIdx + 3] = p3;
+        }
+        for (; xIdx < w; xIdx++) {
+            dstP[xIdx] = srcLUT[srcP[xIdx]];
+        }
+        return;
+    }
+
+    for (; xIdx < w; xIdx++, dstP += pixelStride) {
+        *dstP = srcLUT[*srcP++];
+    }
+}
+
+/*
+ * Reverse lookup table used by compareLUTs() to map an opaque color of
+ * the new palette to its slot in the current palette.  It is an open
+ * addressed hash of at most 256 colors, so a table of twice that size
+ * keeps the probe sequences short.  Only the first slot holding a given
+ * color is recorded, matching the result of a linear search.
+ */
+#define RLUT_SIZE 512
+#define RLUT_HASH(rgb) ((((unsigned int) (rgb)) * 0x9E3779B1U) >> 23)
+
+typedef struct {
+    short idx[RLUT_SIZE];
+    unsigned int rgb[RLUT_SIZE];
+} ReverseLUT;
+
+static void rlutInit(ReverseLUT *rlut) {
+    memset(rlut->idx, 0xff, sizeof(rlut->idx));
+}
+
+static void rlutAdd(ReverseLUT *rlut, unsigned int rgb, int idx) {
+    unsigned int h = RLUT_HASH(rgb);
+    while (rlut->idx[h] >= 0) {
+        if (rlut->rgb[h] == rgb) {
+            /* keep the lowest slot */
+            return;
+        }
+        h = (h + 1) & (RLUT_SIZE - 1);
+    }
+    rlut->idx[h] = (short) idx;
+    rlut->rgb[h] = rgb;
+}
+
+static int rlutFind(ReverseLUT *rlut, unsigned int rgb) {
+    unsigned int h = RLUT_HASH(rgb);
+    while (rlut->idx[h] >= 0) {
+        if (rlut->rgb[h] == rgb) {
+            return rlut->idx[h];
+        }
+        h = (h + 1) & (RLUT_SIZE - 1);
+    }
+    return -1;
+}
+
 static int compareLUTs(unsigned int *lut1, int numLut1, int transIdx,
                        unsigned int *lut2, int numLut2, unsigned char *cvtLut,
                        int *retNumLut1, int *retTransIdx, int *jniFlagP)
@@ -400,6 +520,8 @@ static int compareLUTs(unsigned int *lut1, int numLut1, int transIdx,
     unsigned int rgb;
     int changed = FALSE;
     int maxSize = (numLut1 > numLut2 ? numLut1 : numLut2);
+    int rlutSize = -1;
+    ReverseLUT rlut;
 
     *jniFlagP = JNI_ABORT;
 
@@ -434,7 +556,18 @@ static int compareLUTs(unsigned int *lut1, int numLut1, int transIdx,
                 cvtLut[i] = transIdx;
             }
             else {
-                if ((idx = findIdx(rgb, lut1, numLut1)) == -1) {
+                /* The reverse table is built on the first miss only, so
+                 * palettes that match slot by slot do not pay for it.
+                 * Slots appended since then are added before searching.
+                 */
+                if (rlutSize < 0) {
+                    rlutInit(&rlut);
+                    rlutSize = 0;
+                }
+                for (; rlutSize < numLut1; rlutSize++) {
+                    rlutAdd(&rlut, lut1[rlutSize], rlutSize);
+                }
+                if ((idx = rlutFind(&rlut, rgb)) == -1) {
                     if (numLut1 < 256) {
                         lut1[numLut1] = rgb;
                         cvtLut[i] = numLut1;
@@ -461,19 +594,3 @@ static int compareLUTs(unsigned int *lut1, int numLut1, int transIdx,
     }
     return TRUE;
 }
-
-static int findIdx(unsigned int rgb, unsigned int *lut, int numLut) {
-    int i;
-
-    if ((rgb&0xff000000)==0) {
-        for (i=0; i < numLut; i++) {
-            if ((lut[i]&0xff000000)==0) return i;
-        }
-    }
-    else {
-        for (i=0; i < numLut; i++) {
-            if (lut[i] == rgb) return i;
-        }
-    }
-    return -1;
-}
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2001, 2018, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2001, 2026, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -105,55 +105,61 @@ void freeICMColorData(ColorData *pData) {
  * palette entries map to the same cube vertex
  */
 
+/*
+ * Grows the regions claimed by the palette entries one cube step at a
+ * time until every cell of the cube has been claimed.  Each level is
+ * produced from the entries activated by the previous level, visited in
+ * reverse order, so the result matches a depth-first recursion over the
+ * levels.  The two level buffers are sized for the whole cube since every
+ * cell is activated at most once, which avoids an allocation per level.
+ */
 static int
-recurseLevel(CubeStateInfo *priorState) {
-    int i;
+expandCubeLevels(CubeStateInfo *initialState, int cubesize) {
+    unsigned int i;
+    CubeStateInfo priorState;
     CubeStateInfo currentState;
-    memcpy(&currentState, priorState, sizeof(CubeStateInfo));
-
+    unsigned short *rgbBufs[2];
+    unsigned char *indexBufs[2];
+    int cur = 0;
 
-    currentState.rgb = (unsigned short *)malloc(6
-                                                * sizeof(unsigned short)
-                                                * priorState->activeEntries);
-    if (currentState.rgb == NULL) {
+    rgbBufs[0] = (unsigned short *)malloc(2 * cubesize * sizeof(unsigned short));
+    if (rgbBufs[0] == NULL) {
         return 0;
     }
-
-    currentState.indices = (unsigned char *)malloc(6
-                                                * sizeof(unsigned char)
-                                                * priorState->activeEntries);
-
-    if (currentState.indices == NULL) {
-        free(currentState.rgb);
+    indexBufs[0] = (unsigned char *)malloc(2 * cubesize * sizeof(unsigned char));
+    if (indexBufs[0] == NULL) {
+        free(rgbBufs[0]);
         return 0;
     }
-
-    currentState.depth++;
-    if (currentState.depth > priorState->maxDepth) {
-        priorState->maxDepth = currentState.depth;
-    }
-    currentState.activeEntries = 0;
-    for (i=priorState->activeEntries - 1; i >= 0; i--) {
-        unsigned short rgb = priorState->rgb[i];
-        unsigned char  index = priorState->indices[i];
-        ACTIVATE(rgb, 0x7c00, 0x0400, currentState, index);
-        ACTIVATE(rgb, 0x03e0, 0x0020, currentState, index);
-        ACTIVATE(rgb, 0x001f, 0x0001, currentState, index);
-    }
-    if (currentState.activeEntries) {
-        if (!recurseLevel(&currentState)) {
-            free(currentState.rgb);
-            free(currentState.indices);
-            return 0;
+    rgbBufs[1] = rgbBufs[0] + cubesize;
+    indexBufs[1] = indexBufs[0] + cubesize;
+
+    memcpy(&priorState, initialState, sizeof(CubeStateInfo));
+    memcpy(&currentState, initialState, sizeof(CubeStateInfo));
+
+    while (priorState.activeEntries) {
+        currentState.rgb = rgbBufs[cur];
+        currentState.indices = indexBufs[cur];
+        currentState.activeEntries = 0;
+        currentState.depth = priorState.depth + 1;
+        for (i = priorState.activeEntries; i-- > 0; ) {
+            unsigned short rgb = priorState.rgb[i];
+            unsigned char  index = priorState.indices[i];
+            ACTIVATE(rgb, 0x7c00, 0x0400, currentState, index);
+            ACTIVATE(rgb, 0x03e0, 0x0020, currentState, index);
+            ACTIVATE(rgb, 0x001f, 0x0001, currentState, index);
         }
-    }
-    if (currentState.maxDepth > priorState->maxDepth) {
-        priorState->maxDepth = currentState.maxDepth;
+        if (currentState.activeEntries &&
+            currentState.depth > initialState->maxDepth) {
+            initialState->maxDepth = currentState.depth;
+        }
+        memcpy(&priorState, &currentState, sizeof(CubeStateInfo));
+        cur ^= 1;
     }
 
-    free(currentState.rgb);
-    free(currentState.indices);
-    return  1;
+    free(rgbBufs[0]);
+    free(indexBufs[0]);
+    return 1;
 }
 
 /*
@@ -227,7 +233,7 @@ initCubemap(int* cmap,
             INSERTNEW(currentState, rgb, cmap_len - i - 1);
         }
 
-        if (!recurseLevel(&currentState)) {
+        if (!expandCubeLevels(&currentState, cubesize)) {
             free(newILut);
             free(useFlags);
             free(currentState.rgb);
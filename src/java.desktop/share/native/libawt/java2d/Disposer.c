@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2002, 2013, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2002, 2026, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -22,11 +22,56 @@
  * or visit www.oracle.com if you need additional information or have any
  * questions.
  */
+#include <stdlib.h>
+
 #include "jni_util.h"
+#include "jvm.h"
 #include "Disposer.h"
 
+#ifdef _WIN32
+#include <windows.h>
+#define CAS_PTR(p, o, n) \
+    (InterlockedCompareExchangePointer((PVOID volatile *)(p), (n), (o)) == (o))
+#define XCHG_PTR(p, n)   InterlockedExchangePointer((PVOID volatile *)(p), (n))
+#define LOAD_PTR(p)      (*(p))
+#define ADD_LONG(p, v)   InterlockedExchangeAdd64((LONGLONG volatile *)(p), (v))
+#define LOAD_LONG(p)     InterlockedCompareExchange64((LONGLONG volatile *)(p), 0, 0)
+#define CAS_LONG(p, o, n) \
+    (InterlockedCompareExchange64((LONGLONG volatile *)(p), (n), (o)) == (o))
+#else
+#define CAS_PTR(p, o, n) \
+    __atomic_compare_exchange_n((p), &(o), (n), 0, \
+                                __ATOMIC_RELEASE, __ATOMIC_RELAXED)
+#define XCHG_PTR(p, n)   __atomic_exchange_n((p), (n), __ATOMIC_ACQUIRE)
+#define LOAD_PTR(p)      __atomic_load_n((p), __ATOMIC_RELAXED)
+#define ADD_LONG(p, v)   __atomic_fetch_add((p), (v), __ATOMIC_RELAXED)
+#define LOAD_LONG(p)     __atomic_load_n((p), __ATOMIC_RELAXED)
+#define CAS_LONG(p, o, n) \
+    __atomic_compare_exchange_n((p), &(o), (n), 0, \
+                                __ATOMIC_RELAXED, __ATOMIC_RELAXED)
+#endif
+
 static jmethodID addRecordMID = NULL;
 static jclass dispClass = NULL;
+static JavaVM *dispJVM = NULL;
+
+/*
+ * Native data queued by Disposer_DeferDispose.  Producers push on a
+ * Treiber stack; the consumer takes the whole stack with one exchange,
+ * so no node is ever popped individually and there is no ABA problem.
+ */
+typedef struct _DeferredRecord {
+    struct _DeferredRecord *next;
+    GeneralDisposeFunc     *disposer;
+    jlong                   pData;
+    jlong                   queuedAt;
+} DeferredRecord;
+
+static DeferredRecord *volatile deferredHead = NULL;
+
+static volatile jlong deferredStats[DISPOSER_STAT_COUNT];
+
+#define DISPOSE_BATCH_SIZE 64
 
 /*
  * Class:     sun_java2d_Disposer
@@ -41,6 +86,9 @@ Java_sun_java2d_Disposer_initIDs(JNIEnv *env, jclass disposerClass)
     if (addRecordMID != 0) {
         dispClass = (*env)->NewGlobalRef(env, disposerClass);
     }
+    if ((*env)->GetJavaVM(env, &dispJVM) != JNI_OK) {
+        dispJVM = NULL;
+    }
 }
 
 JNIEXPORT void JNICALL
@@ -73,3 +121,163 @@ Java_sun_java2d_DefaultDisposerRecord_invokeNativeDispose(JNIEnv *env, jclass di
         disposeMethod(env, pData);
     }
 }
+
+/*
+ * Class:     sun_java2d_DefaultDisposerRecord
+ * Method:    invokeNativeDisposeBatch
+ * Signature: ([J[JI)V
+ *
+ * Disposes of count records collected by the Disposer thread with a
+ * single native call.
+ */
+JNIEXPORT void JNICALL
+Java_sun_java2d_DefaultDisposerRecord_invokeNativeDisposeBatch
+    (JNIEnv *env, jclass dispClass,
+     jlongArray disposers, jlongArray pDatas, jint count)
+{
+    jlong disposerBuf[DISPOSE_BATCH_SIZE];
+    jlong pDataBuf[DISPOSE_BATCH_SIZE];
+    jint start, i;
+
+    if (disposers == NULL || pDatas == NULL) {
+        JNU_ThrowNullPointerException(env, "record array");
+        return;
+    }
+    if (count < 0 ||
+        count > (*env)->GetArrayLength(env, disposers) ||
+        count > (*env)->GetArrayLength(env, pDatas))
+    {
+        JNU_ThrowArrayIndexOutOfBoundsException(env, "record count");
+        return;
+    }
+
+    for (start = 0; start < count; start += DISPOSE_BATCH_SIZE) {
+        jint n = count - start;
+        if (n > DISPOSE_BATCH_SIZE) {
+            n = DISPOSE_BATCH_SIZE;
+        }
+        (*env)->GetLongArrayRegion(env, disposers, start, n, disposerBuf);
+        (*env)->GetLongArrayRegion(env, pDatas, start, n, pDataBuf);
+        for (i = 0; i < n; i++) {
+            if (disposerBuf[i] != 0 && pDataBuf[i] != 0) {
+                GeneralDisposeFunc *disposeMethod =
+                    (GeneralDisposeFunc*)(jlong_to_ptr(disposerBuf[i]));
+                disposeMethod(env, pDataBuf[i]);
+            }
+        }
+    }
+}
+
+JNIEXPORT void JNICALL
+Disposer_DeferDispose(GeneralDisposeFunc disposer, jlong pData)
+{
+    DeferredRecord *pRec;
+    DeferredRecord *head;
+
+    if (disposer == NULL || pData == 0) {
+        return;
+    }
+    pRec = (DeferredRecord *) malloc(sizeof(DeferredRecord));
+    if (pRec == NULL) {
+        /* Better to dispose of it right away than to leak it */
+        JNIEnv *env = NULL;
+        if (dispJVM != NULL &&
+            (*dispJVM)->GetEnv(dispJVM, (void **) &env,
+                               JNI_VERSION_1_2) == JNI_OK)
+        {
+            disposer(env, pData);
+        }
+        return;
+    }
+    pRec->disposer = disposer;
+    pRec->pData = pData;
+    pRec->queuedAt = JVM_NanoTime(NULL, NULL);
+
+    ADD_LONG(&deferredStats[DISPOSER_STAT_ENQUEUED], 1);
+    do {
+        head = LOAD_PTR(&deferredHead);
+        pRec->next = head;
+    } while (!CAS_PTR(&deferredHead, head, pRec));
+}
+
+/*
+ * Class:     sun_java2d_Disposer
+ * Method:    drainNativeQueue
+ * Signature: ()I
+ *
+ * Disposes of all data queued by Disposer_DeferDispose, oldest first,
+ * and returns the number of records disposed of.
+ */
+JNIEXPORT jint JNICALL
+Java_sun_java2d_Disposer_drainNativeQueue(JNIEnv *env, jclass dispClass)
+{
+    DeferredRecord *pList = (DeferredRecord *) XCHG_PTR(&deferredHead, NULL);
+    DeferredRecord *pFifo = NULL;
+    jlong now, maxLatency, totalLatency = 0, oldMax;
+    jint count = 0;
+
+    if (pList == NULL) {
+        return 0;
+    }
+    while (pList != NULL) {
+        DeferredRecord *pNext = pList->next;
+        pList->next = pFifo;
+        pFifo = pList;
+        pList = pNext;
+    }
+
+    now = JVM_NanoTime(env, NULL);
+    maxLatency = 0;
+    while (pFifo != NULL) {
+        DeferredRecord *pNext = pFifo->next;
+        jlong latency = now - pFifo->queuedAt;
+        if (latency > maxLatency) {
+            maxLatency = latency;
+        }
+        totalLatency += latency;
+        pFifo->disposer(env, pFifo->pData);
+        free(pFifo);
+        pFifo = pNext;
+        count++;
+    }
+
+    ADD_LONG(&deferredStats[DISPOSER_STAT_RECLAIMED], count);
+    ADD_LONG(&deferredStats[DISPOSER_STAT_BATCHES], 1);
+    ADD_LONG(&deferredStats[DISPOSER_STAT_TOTAL_LATENCY], totalLatency);
+    do {
+        oldMax = LOAD_LONG(&deferredStats[DISPOSER_STAT_MAX_LATENCY]);
+    } while (maxLatency > oldMax &&
+             !CAS_LONG(&deferredStats[DISPOSER_STAT_MAX_LATENCY],
+                       oldMax, maxLatency));
+    return count;
+}
+
+/*
+ * Class:     sun_java2d_Disposer
+ * Method:    getNativeQueueStats
+ * Signature: ([J)V
+ *
+ * Fills stats with the values indexed by the DISPOSER_STAT_* constants.
+ */
+JNIEXPORT void JNICALL
+Java_sun_java2d_Disposer_getNativeQueueStats(JNIEnv *env, jclass dispClass,
+                                             jlongArray stats)
+{
+    jlong values[DISPOSER_STAT_COUNT];
+    jint i;
+
+    if (stats == NULL) {
+        JNU_ThrowNullPointerException(env, "stats");
+        return;
+    }
+    if ((*env)->GetArrayLength(env, stats) < DISPOSER_STAT_COUNT) {
+        JNU_ThrowArrayIndexOutOfBoundsException(env, "stats");
+        return;
+    }
+    for (i = 0; i < DISPOSER_STAT_COUNT; i++) {
+        values[i] = LOAD_LONG(&deferredStats[i]);
+    }
+    values[DISPOSER_STAT_DEPTH] = values[DISPOSER_STAT_ENQUEUED] -
+                                  values[DISPOSER_STAT_RECLAIMED];
+    (*env)->SetLongArrayRegion(env, stats, 0, DISPOSER_STAT_COUNT, values);
+}
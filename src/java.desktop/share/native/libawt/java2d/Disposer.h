@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2002, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2002, 2026, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -46,6 +46,27 @@ JNIEXPORT void JNICALL
 Disposer_AddRecord(JNIEnv *env, jobject obj,
                    GeneralDisposeFunc disposer, jlong pData);
 
+/*
+ * This method is used for releasing native data which no longer has an
+ * owning Java object.  The data is pushed on a lock-free queue and is
+ * disposed of, together with any other pending data, the next time the
+ * Disposer thread drains the queue.  It makes no JNI calls and may be
+ * used from any thread, including from inside a dispose function.
+ */
+JNIEXPORT void JNICALL
+Disposer_DeferDispose(GeneralDisposeFunc disposer, jlong pData);
+
+/*
+ * Indices of the values reported by Disposer.getNativeQueueStats().
+ */
+#define DISPOSER_STAT_DEPTH             0   /* records currently queued */
+#define DISPOSER_STAT_ENQUEUED          1   /* records queued so far */
+#define DISPOSER_STAT_RECLAIMED         2   /* records disposed so far */
+#define DISPOSER_STAT_BATCHES           3   /* non-empty drains */
+#define DISPOSER_STAT_MAX_LATENCY       4   /* longest queued time, ns */
+#define DISPOSER_STAT_TOTAL_LATENCY     5   /* sum of queued times, ns */
+#define DISPOSER_STAT_COUNT             6
+
 #ifdef __cplusplus
 }
 #endif
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2000, 2004, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2000, 2026, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -143,7 +143,103 @@ jboolean checkSameLut(jint *SrcReadLut, jint *DstReadLut,
     return JNI_TRUE;
 }
 
-DEFINE_CONVERT_BLIT(IntArgb, ByteIndexed, 3ByteRgb)
+/*
+ * The IntArgb (and IntRgb, IntArgbBm) to ByteIndexed conversion is the
+ * loop used to reduce true color images to an indexed color model, so
+ * it is written out by hand rather than generated by DEFINE_CONVERT_BLIT.
+ * The dither errors of a row are rotated once so that lane i of every
+ * group of 8 pixels uses the same error entry, which lets the compiler
+ * vectorize the dither, clamp and index arithmetic.  Only the inverse
+ * color table lookup remains scalar.  The output is identical to that
+ * of the generic StoreByteIndexedFrom3ByteRgb macro.
+ */
+#define BI_DITHER_GROUP 8
+
+static void
+IntArgbToByteIndexedRow(jint *pSrc, jubyte *pDst, juint width,
+                        signed char *rerr, signed char *gerr,
+                        signed char *berr, jint xDither,
+                        jint repPrims, unsigned char *invLut)
+{
+    jint re[BI_DITHER_GROUP], ge[BI_DITHER_GROUP], be[BI_DITHER_GROUP];
+    jint idx[BI_DITHER_GROUP];
+    juint x = 0;
+    jint i;
+
+    for (i = 0; i < BI_DITHER_GROUP; i++) {
+        re[i] = rerr[(xDither + i) & 7];
+        ge[i] = gerr[(xDither + i) & 7];
+        be[i] = berr[(xDither + i) & 7];
+    }
+
+    for (; x + BI_DITHER_GROUP <= width; x += BI_DITHER_GROUP) {
+        jint *pRow = pSrc + x;
+        for (i = 0; i < BI_DITHER_GROUP; i++) {
+            jint rgb = pRow[i];
+            jint r = (rgb >> 16) & 0xff;
+            jint g = (rgb >>  8) & 0xff;
+            jint b = (rgb      ) & 0xff;
+            jint prim = repPrims &
+                ((r == 0) | (r == 255)) &
+                ((g == 0) | (g == 255)) &
+                ((b == 0) | (b == 255));
+            r += prim ? 0 : re[i];
+            g += prim ? 0 : ge[i];
+            b += prim ? 0 : be[i];
+            r = (r < 0) ? 0 : ((r > 255) ? 255 : r);
+            g = (g < 0) ? 0 : ((g > 255) ? 255 : g);
+            b = (b < 0) ? 0 : ((b > 255) ? 255 : b);
+            idx[i] = ((r >> 3) << 10) + ((g >> 3) << 5) + (b >> 3);
+        }
+        for (i = 0; i < BI_DITHER_GROUP; i++) {
+            pDst[x + i] = invLut[idx[i]];
+        }
+    }
+
+    for (i = 0; x < width; x++, i++) {
+        jint rgb = pSrc[x];
+        jint r = (rgb >> 16) & 0xff;
+        jint g = (rgb >>  8) & 0xff;
+        jint b = (rgb      ) & 0xff;
+        if (!(((r == 0) || (r == 255)) &&
+              ((g == 0) || (g == 255)) &&
+              ((b == 0) || (b == 255)) &&
+              repPrims)) {
+            r += re[i];
+            g += ge[i];
+            b += be[i];
+        }
+        ByteClamp3Components(r, g, b);
+        pDst[x] = SurfaceData_InvColorMap(invLut, r, g, b);
+    }
+}
+
+void NAME_CONVERT_BLIT(IntArgb, ByteIndexed)
+    (void *srcBase, void *dstBase,
+     juint width, juint height,
+     SurfaceDataRasInfo *pSrcInfo,
+     SurfaceDataRasInfo *pDstInfo,
+     NativePrimitive *pPrim,
+     CompositeInfo *pCompInfo)
+{
+    jint srcScan = pSrcInfo->scanStride;
+    jint dstScan = pDstInfo->scanStride;
+    jint xDither = pDstInfo->bounds.x1 & 7;
+    jint yDither = (pDstInfo->bounds.y1 & 7) << 3;
+    jint repPrims = pDstInfo->representsPrimaries ? 1 : 0;
+    unsigned char *invLut = pDstInfo->invColorTable;
+
+    do {
+        IntArgbToByteIndexedRow((jint *) srcBase, (jubyte *) dstBase, width,
+                                pDstInfo->redErrTable + yDither,
+                                pDstInfo->grnErrTable + yDither,
+                                pDstInfo->bluErrTable + yDither,
+                                xDither, repPrims, invLut);
+        srcBase = PtrAddBytes(srcBase, srcScan);
+        dstBase = PtrAddBytes(dstBase, dstScan);
+        yDither = (yDither + (1 << 3)) & (7 << 3);
+    } while (--height > 0);
+}
 
 DEFINE_CONVERT_BLIT(ThreeByteBgr, ByteIndexed, 3ByteRgb)
 
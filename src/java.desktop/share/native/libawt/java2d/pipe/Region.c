@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2002, 2013, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2002, 2026, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -26,6 +26,7 @@
 #include <stdlib.h>
 
 #include "jni_util.h"
+#include "jvm.h"
 
 #include "Region.h"
 #include "sizecalc.h"
@@ -37,6 +38,25 @@ static jfieldID loyID;
 static jfieldID hixID;
 static jfieldID hiyID;
 
+/*
+ * Cache of native copies of the bands of complex regions, see
+ * RegionCachedBands in Region.h.  An entry is only replaced once its
+ * Region has been collected, so a caller which holds a reference to a
+ * Region can use the cached copy without holding the cache lock.  When
+ * all entries refer to live regions, new regions are simply not cached.
+ */
+#define REGION_CACHE_SIZE       32
+#define REGION_CACHE_MIN_INTS   64          /* smaller regions are cheap to scan */
+#define REGION_CACHE_MAX_INTS   (1 << 20)   /* 4MB per cached region */
+
+typedef struct {
+    jweak               region;
+    RegionCachedBands   cached;
+} RegionCacheEntry;
+
+static RegionCacheEntry regionCache[REGION_CACHE_SIZE];
+static void *regionCacheLock;
+
 #define InitField(var, env, jcl, name, type) \
 do { \
     var = (*env)->GetFieldID(env, jcl, name, type); \
@@ -60,6 +80,203 @@ Java_sun_java2d_pipe_Region_initIDs(JNIEnv *env, jclass reg)
     InitField(loyID, env, reg, "loy", "I");
     InitField(hixID, env, reg, "hix", "I");
     InitField(hiyID, env, reg, "hiy", "I");
+
+    if (regionCacheLock == NULL) {
+        regionCacheLock = JVM_RawMonitorCreate();
+    }
+}
+
+static void
+freeCachedBands(RegionCachedBands *pCached)
+{
+    free(pCached->pBands);
+    free(pCached->pBandStarts);
+    pCached->pBands = NULL;
+    pCached->pBandStarts = NULL;
+    pCached->endIndex = 0;
+    pCached->numBands = 0;
+}
+
+/*
+ * Copies the bands of the region and records where each Y band starts.
+ * Returns JNI_FALSE if the bands are malformed or memory is short.
+ */
+static jboolean
+buildCachedBands(JNIEnv *env, jintArray bands, jint endIndex,
+                 RegionCachedBands *pCached)
+{
+    jint *pBands;
+    jint *pStarts;
+    jint index, numBands;
+
+    pBands = (jint *) SAFE_SIZE_ARRAY_ALLOC(malloc, endIndex, sizeof(jint));
+    if (pBands == NULL) {
+        return JNI_FALSE;
+    }
+    (*env)->GetIntArrayRegion(env, bands, 0, endIndex, pBands);
+    if ((*env)->ExceptionCheck(env)) {
+        (*env)->ExceptionClear(env);
+        free(pBands);
+        return JNI_FALSE;
+    }
+
+    /* each band takes at least 3 ints */
+    pStarts = (jint *) SAFE_SIZE_ARRAY_ALLOC(malloc, endIndex / 3 + 1,
+                                             sizeof(jint));
+    if (pStarts == NULL) {
+        free(pBands);
+        return JNI_FALSE;
+    }
+    numBands = 0;
+    index = 0;
+    while (index < endIndex) {
+        jint numrects;
+        if (index + 3 > endIndex) {
+            break;
+        }
+        numrects = pBands[index + 2];
+        if (numrects < 0 || numrects > (endIndex - index - 3) / 2) {
+            break;
+        }
+        pStarts[numBands++] = index;
+        index += 3 + numrects * 2;
+    }
+    if (index != endIndex) {
+        free(pStarts);
+        free(pBands);
+        return JNI_FALSE;
+    }
+
+    pCached->endIndex = endIndex;
+    pCached->pBands = pBands;
+    pCached->numBands = numBands;
+    pCached->pBandStarts = pStarts;
+    return JNI_TRUE;
+}
+
+JNIEXPORT RegionCachedBands * JNICALL
+Region_GetCachedBands(JNIEnv *env, jobject region,
+                      jintArray bands, jint endIndex)
+{
+    RegionCachedBands built;
+    RegionCacheEntry *pFree = NULL;
+    RegionCachedBands *pResult = NULL;
+    jweak ref;
+    int i;
+
+    if (regionCacheLock == NULL || JNU_IsNull(env, region) ||
+        JNU_IsNull(env, bands) ||
+        endIndex < REGION_CACHE_MIN_INTS || endIndex > REGION_CACHE_MAX_INTS)
+    {
+        return NULL;
+    }
+
+    JVM_RawMonitorEnter(regionCacheLock);
+    for (i = 0; i < REGION_CACHE_SIZE; i++) {
+        RegionCacheEntry *pEntry = &regionCache[i];
+        if (pEntry->region != NULL &&
+            (*env)->IsSameObject(env, pEntry->region, region) &&
+            pEntry->cached.endIndex == endIndex)
+        {
+            pResult = &pEntry->cached;
+            break;
+        }
+    }
+    JVM_RawMonitorExit(regionCacheLock);
+    if (pResult != NULL) {
+        return pResult;
+    }
+
+    if ((*env)->GetArrayLength(env, bands) < endIndex ||
+        !buildCachedBands(env, bands, endIndex, &built))
+    {
+        return NULL;
+    }
+    ref = (*env)->NewWeakGlobalRef(env, region);
+    if (ref == NULL) {
+        (*env)->ExceptionClear(env);
+        freeCachedBands(&built);
+        return NULL;
+    }
+
+    JVM_RawMonitorEnter(regionCacheLock);
+    for (i = 0; i < REGION_CACHE_SIZE; i++) {
+        RegionCacheEntry *pEntry = &regionCache[i];
+        if (pEntry->region == NULL) {
+            if (pFree == NULL) {
+                pFree = pEntry;
+            }
+        } else if ((*env)->IsSameObject(env, pEntry->region, region) &&
+                   pEntry->cached.endIndex == endIndex) {
+            /* another thread got here first */
+            pResult = &pEntry->cached;
+            break;
+        } else if ((*env)->IsSameObject(env, pEntry->region, NULL)) {
+            /* the region was collected, so nobody can be using the copy */
+            (*env)->DeleteWeakGlobalRef(env, pEntry->region);
+            pEntry->region = NULL;
+            freeCachedBands(&pEntry->cached);
+            if (pFree == NULL) {
+                pFree = pEntry;
+            }
+        }
+    }
+    if (pResult == NULL && pFree != NULL) {
+        pFree->region = ref;
+        pFree->cached = built;
+        pResult = &pFree->cached;
+        ref = NULL;
+    }
+    JVM_RawMonitorExit(regionCacheLock);
+
+    if (ref != NULL) {
+        (*env)->DeleteWeakGlobalRef(env, ref);
+        freeCachedBands(&built);
+    }
+    return pResult;
+}
+
+JNIEXPORT jint JNICALL
+Region_FindBand(RegionCachedBands *pCached, jint y)
+{
+    jint *pBands = pCached->pBands;
+    jint *pStarts = pCached->pBandStarts;
+    jint lo = 0;
+    jint hi = pCached->numBands;
+
+    /* the bands are sorted and disjoint, so their y2 values increase */
+    while (lo < hi) {
+        jint mid = (lo + hi) >> 1;
+        if (pBands[pStarts[mid] + 1] <= y) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return (lo < pCached->numBands) ? pStarts[lo] : pCached->endIndex;
+}
+
+JNIEXPORT jint JNICALL
+Region_SkipXBands(jint *pBands, jint index, jint numrects, jint x)
+{
+    jint lo = 0;
+    jint hi = numrects;
+
+    if (numrects <= 8) {
+        while (lo < numrects && pBands[index + lo * 2 + 1] <= x) {
+            lo++;
+        }
+        return lo;
+    }
+    while (lo < hi) {
+        jint mid = (lo + hi) >> 1;
+        if (pBands[index + mid * 2 + 1] <= x) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
 }
 
 JNIEXPORT jint JNICALL
@@ -79,6 +296,10 @@ Region_GetInfo(JNIEnv *env, jobject region, RegionData *pRgnInfo)
     pRgnInfo->bands = (Region_IsRectangular(pRgnInfo)
                        ? NULL
                        : (*env)->GetObjectField(env, region, bandsID));
+    pRgnInfo->pCached = (Region_IsRectangular(pRgnInfo)
+                         ? NULL
+                         : Region_GetCachedBands(env, region, pRgnInfo->bands,
+                                                 pRgnInfo->endIndex));
     return 0;
 }
 
@@ -99,11 +320,17 @@ Region_GetBounds(JNIEnv *env, jobject region, SurfaceDataBounds *b)
 JNIEXPORT void JNICALL
 Region_StartIteration(JNIEnv *env, RegionData *pRgnInfo)
 {
-    pRgnInfo->pBands =
-        (Region_IsRectangular(pRgnInfo)
-         ? NULL
-         : (*env)->GetPrimitiveArrayCritical(env, pRgnInfo->bands, 0));
-    pRgnInfo->index = 0;
+    if (pRgnInfo->pCached != NULL) {
+        pRgnInfo->pBands = pRgnInfo->pCached->pBands;
+        pRgnInfo->index = Region_FindBand(pRgnInfo->pCached,
+                                          pRgnInfo->bounds.y1);
+    } else {
+        pRgnInfo->pBands =
+            (Region_IsRectangular(pRgnInfo)
+             ? NULL
+             : (*env)->GetPrimitiveArrayCritical(env, pRgnInfo->bands, 0));
+        pRgnInfo->index = 0;
+    }
     pRgnInfo->numrects = 0;
 }
 
@@ -117,7 +344,9 @@ Region_CountIterationRects(RegionData *pRgnInfo)
         totalrects = 1;
     } else {
         jint *pBands = pRgnInfo->pBands;
-        int index = 0;
+        int index = (pRgnInfo->pCached != NULL)
+            ? Region_FindBand(pRgnInfo->pCached, pRgnInfo->bounds.y1)
+            : 0;
         totalrects = 0;
         while (index < pRgnInfo->endIndex) {
             jint xy1 = pBands[index++];
@@ -127,6 +356,10 @@ Region_CountIterationRects(RegionData *pRgnInfo)
                 break;
             }
             if (xy2 > pRgnInfo->bounds.y1) {
+                jint skip = Region_SkipXBands(pBands, index, numrects,
+                                              pRgnInfo->bounds.x1);
+                index += skip * 2;
+                numrects -= skip;
                 while (numrects > 0) {
                     xy1 = pBands[index++];
                     xy2 = pBands[index++];
@@ -186,6 +419,15 @@ Region_NextIteration(RegionData *pRgnInfo, SurfaceDataBounds *pSpan)
                 }
                 pSpan->y1 = xy1;
                 pSpan->y2 = xy2;
+                if (numrects > 0) {
+                    jint skip = Region_SkipXBands(pBands, index, numrects,
+                                                  pRgnInfo->bounds.x1);
+                    index += skip * 2;
+                    numrects -= skip;
+                    if (numrects <= 0) {
+                        continue;
+                    }
+                }
             }
             xy1 = pBands[index++];
             xy2 = pBands[index++];
@@ -216,7 +458,7 @@ Region_NextIteration(RegionData *pRgnInfo, SurfaceDataBounds *pSpan)
 JNIEXPORT void JNICALL
 Region_EndIteration(JNIEnv *env, RegionData *pRgnInfo)
 {
-    if (pRgnInfo->endIndex != 0) {
+    if (pRgnInfo->endIndex != 0 && pRgnInfo->pCached == NULL) {
         (*env)->ReleasePrimitiveArrayCritical(env, pRgnInfo->bands,
                                               pRgnInfo->pBands, JNI_ABORT);
     }
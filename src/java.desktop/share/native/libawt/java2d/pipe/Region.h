@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2002, 2007, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2002, 2026, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -60,6 +60,21 @@ extern "C" {
  *      }
  */
 
+/*
+ * A native copy of the bands of a complex Java Region together with the
+ * offset of every Y band, so that the first band intersecting a given
+ * scanline can be found with a binary search.  Copies are kept in a small
+ * cache keyed by the Java Region object, which is immutable once it is
+ * handed to native code, and stay valid for as long as the caller holds
+ * a reference to that Region.
+ */
+typedef struct {
+    jint                endIndex;
+    jint                *pBands;
+    jint                numBands;
+    jint                *pBandStarts;
+} RegionCachedBands;
+
 /*
  * This structure is not meant to be accessed by code outside of
  * Region.h or Region.c.  It is exposed here so that callers can
@@ -72,6 +87,7 @@ typedef struct {
     jint                index;
     jint                numrects;
     jint                *pBands;
+    RegionCachedBands   *pCached;
 } RegionData;
 
 /*
@@ -98,6 +114,37 @@ Region_GetInfo(JNIEnv *env, jobject region, RegionData *pRgnInfo);
 JNIEXPORT void JNICALL
 Region_GetBounds(JNIEnv *env, jobject region, SurfaceDataBounds *b);
 
+/*
+ * Return the cached native copy of the bands of a complex Java Region,
+ * creating it if needed, or NULL if the Region is too small to benefit
+ * from the cache or the cache is full.  The result may be used without
+ * any JNI Critical locks for as long as the caller keeps a reference to
+ * the Region.
+ *
+ * Note to callers:
+ *      This function may use JNI methods so it is important that the
+ *      caller not have any outstanding GetPrimitiveArrayCritical or
+ *      GetStringCritical locks which have not been released.
+ */
+JNIEXPORT RegionCachedBands * JNICALL
+Region_GetCachedBands(JNIEnv *env, jobject region,
+                      jintArray bands, jint endIndex);
+
+/*
+ * Return the index in pCached->pBands of the first Y band which ends
+ * below the scanline y, or pCached->endIndex if there is none.
+ */
+JNIEXPORT jint JNICALL
+Region_FindBand(RegionCachedBands *pCached, jint y);
+
+/*
+ * Return the number of X bands among the numrects bands stored from
+ * pBands[index] that end at or to the left of x, and so can be skipped
+ * by an iteration which starts at x.
+ */
+JNIEXPORT jint JNICALL
+Region_SkipXBands(jint *pBands, jint index, jint numrects, jint x);
+
 /*
  * Intersect the specified SurfaceDataBounds with the bounds of
  * the indicated RegionData structure.  The Region iteration will
@@ -149,6 +196,10 @@ Region_GetBounds(JNIEnv *env, jobject region, SurfaceDataBounds *b);
  * empty regions, simple rectangular regions and complex regions
  * without loss of generality.
  *
+ * Regions with a cached copy of their bands are iterated from that copy
+ * starting with the first band that intersects the bounds, otherwise the
+ * Java band array is locked for the duration of the iteration.
+ *
  * Note to callers:
  *      This function may use JNI Critical methods so it is important
  *      that the caller not call any other JNI methods after this function
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 1998, 2013, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 1998, 2026, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -30,6 +30,8 @@
 #include "jni.h"
 #include "jni_util.h"
 
+#include "Region.h"
+
 #include "sun_java2d_pipe_SpanClipRenderer.h"
 
 jfieldID pBandsArrayID;
@@ -176,6 +178,7 @@ Java_sun_java2d_pipe_SpanClipRenderer_eraseTile
 {
     jobject region;
     jintArray bandsArray;
+    RegionCachedBands *pCached;
     jint *bands;
     jbyte *alpha;
     jint *box;
@@ -210,6 +213,8 @@ Java_sun_java2d_pipe_SpanClipRenderer_eraseTile
     if (endIndex > (*env)->GetArrayLength(env, bandsArray)) {
         endIndex = (*env)->GetArrayLength(env, bandsArray);
     }
+    /* must be looked up before any critical section is entered */
+    pCached = Region_GetCachedBands(env, region, bandsArray, endIndex);
 
     box = (*env)->GetPrimitiveArrayCritical(env, boxArray, 0);
     if (box == NULL) {
@@ -229,20 +234,40 @@ Java_sun_java2d_pipe_SpanClipRenderer_eraseTile
         return;
     }
 
-    bands = (*env)->GetPrimitiveArrayCritical(env, bandsArray, 0);
-    if (bands == NULL) {
-        (*env)->ReleasePrimitiveArrayCritical(env, boxArray, box, 0);
-        return;
+    if (pCached != NULL) {
+        bands = pCached->pBands;
+    } else {
+        bands = (*env)->GetPrimitiveArrayCritical(env, bandsArray, 0);
+        if (bands == NULL) {
+            (*env)->ReleasePrimitiveArrayCritical(env, boxArray, box, 0);
+            return;
+        }
     }
     alpha = (*env)->GetPrimitiveArrayCritical(env, alphaTile, 0);
     if (alpha == NULL) {
-        (*env)->ReleasePrimitiveArrayCritical(env, bandsArray, bands, 0);
+        if (pCached == NULL) {
+            (*env)->ReleasePrimitiveArrayCritical(env, bandsArray, bands, 0);
+        }
         (*env)->ReleasePrimitiveArrayCritical(env, boxArray, box, 0);
         return;
     }
 
     curIndex = saveCurIndex;
     numXbands = saveNumXbands;
+    if (pCached != NULL) {
+        /*
+         * Jump straight to the first band which reaches below loy.
+         * Leaving numXbands at 0 makes nextYRange resume from there,
+         * just as it would after stepping over the skipped bands.
+         */
+        jint index = Region_FindBand(pCached, loy);
+        if (index > curIndex + numXbands * 2) {
+            curIndex = index;
+            numXbands = 0;
+            saveCurIndex = curIndex;
+            saveNumXbands = numXbands;
+        }
+    }
     firsty = hiy;
     lasty = hiy;
     firstx = hix;
@@ -264,6 +289,11 @@ Java_sun_java2d_pipe_SpanClipRenderer_eraseTile
             box[3] = hiy;
         }
         curx = lox;
+        if (numXbands > 0 && curIndex + numXbands * 2 <= endIndex) {
+            jint skip = Region_SkipXBands(bands, curIndex, numXbands, lox);
+            curIndex += skip * 2;
+            numXbands -= skip;
+        }
         while (nextXBand(box, bands, endIndex, &curIndex, &numXbands)) {
             if (box[2] <= lox) {
                 continue;
@@ -315,7 +345,9 @@ Java_sun_java2d_pipe_SpanClipRenderer_eraseTile
     box[3] = lasty;
 
     (*env)->ReleasePrimitiveArrayCritical(env, alphaTile, alpha, 0);
-    (*env)->ReleasePrimitiveArrayCritical(env, bandsArray, bands, 0);
+    if (pCached == NULL) {
+        (*env)->ReleasePrimitiveArrayCritical(env, bandsArray, bands, 0);
+    }
     (*env)->ReleasePrimitiveArrayCritical(env, boxArray, box, 0);
 
     (*env)->SetIntField(env, ri, pCurIndexID, saveCurIndex);
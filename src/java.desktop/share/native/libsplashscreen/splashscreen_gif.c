@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2005, 2013, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2005, 2026, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -73,254 +73,394 @@ SplashStreamGifInputFunc(GifFileType * gif, GifByteType * buf, int n)
    Returns fixed length (if fix is needed) */
 #define FIX_LENGTH(p, len, pmax) ( ((p) + (len)) > (pmax) ? ((pmax) - (p)) : (len))
 
-int
-SplashDecodeGif(Splash * splash, GifFileType * gif)
-{
+/*
+ * State of a GIF animation which is being decoded frame by frame.  The
+ * graphic control and NETSCAPE2.0 extensions are processed as they are
+ * read, so that the descriptor of the next image is always read ahead and
+ * its presence tells whether the animation has more frames.
+ */
+typedef struct SplashGifDecoder {
+    SplashStream stream;        /* owned copy of the stream once detached */
+    GifFileType *gif;
     int stride;
     int bufferSize;
-    byte_t *pBitmapBits, *pOldBitmapBits;
-    int i, j;
-    int imageIndex;
-    int cx, cy, cw, ch; /* clamped coordinates */
-    const int interlacedOffset[] = { 0, 4, 2, 1, 0 };   /* The way Interlaced image should. */
-    const int interlacedJumps[] = { 8, 8, 4, 2, 1 };    /* be read - offsets and jumps... */
+    byte_t *pBitmapBits;        /* logical screen after the last frame */
+    byte_t *pOldBitmapBits;     /* logical screen for GIF_DISPOSE_RESTORE */
+    GifPixelType *pRaster;      /* raster of the current image */
+    int rasterSize;
+    /* graphic control extension of the next image */
+    int transparentColor;
+    int frameDelay;
+    int disposeMethod;
+} SplashGifDecoder;
+
+static void
+SplashGifResetControl(SplashGifDecoder * dec)
+{
+    dec->transparentColor = -1;
+    dec->frameDelay = 100;
+    dec->disposeMethod = GIF_DISPOSE_RESTORE;
+}
 
-    if (DGifSlurp(gif) == GIF_ERROR) {
-        return 0;
-    }
+/* the code below is loosely based around gif extension processing from win32 libungif sample */
 
-    SplashCleanup(splash);
+static int
+SplashGifReadExtension(Splash * splash, SplashGifDecoder * dec)
+{
+    GifByteType *pExtension;
+    int function;
 
-    if (!SAFE_TO_ALLOC(gif->SWidth, splash->imageFormat.depthBytes)) {
+    if (DGifGetExtension(dec->gif, &function, &pExtension) == GIF_ERROR) {
         return 0;
     }
-    stride = gif->SWidth * splash->imageFormat.depthBytes;
-    if (splash->byteAlignment > 1)
-        stride =
-            (stride + splash->byteAlignment - 1) & ~(splash->byteAlignment - 1);
+    if (pExtension == NULL) {
+        return 1;
+    }
+    switch (function) {
+    case GRAPHICS_EXT_FUNC_CODE:
+        if (pExtension[0] >= 4) {
+            int flag = pExtension[1];
+
+            dec->frameDelay = (((int)pExtension[3]) << 8) | pExtension[2];
+            if (dec->frameDelay < 10)
+                dec->frameDelay = 10;
+            if (flag & GIF_TRANSPARENT) {
+                dec->transparentColor = pExtension[4];
+            } else {
+                dec->transparentColor = GIF_NOT_TRANSPARENT;
+            }
+            dec->disposeMethod =
+                (flag >> GIF_DISPOSE_SHIFT) & GIF_DISPOSE_MASK;
+        }
+        break;
+    case APPLICATION_EXT_FUNC_CODE:
+        if (pExtension[0] == sizeof(szNetscape20ext)
+            && memcmp(pExtension + 1, szNetscape20ext,
+                      sizeof(szNetscape20ext)) == 0) {
+            if (DGifGetExtensionNext(dec->gif, &pExtension) == GIF_ERROR) {
+                return 0;
+            }
+            if (pExtension != NULL && pExtension[0] == 3 &&
+                (pExtension[1] & 0x07) == NSEXT_LOOP) {
+                splash->loopCount =
+                    (pExtension[2] | (((int)pExtension[3]) << 8)) - 1;
+            }
+        }
+        break;
+    default:
+        break;
+    }
+    /* skip the remaining sub-blocks */
+    while (pExtension != NULL) {
+        if (DGifGetExtensionNext(dec->gif, &pExtension) == GIF_ERROR) {
+            return 0;
+        }
+    }
+    return 1;
+}
 
-    if (!SAFE_TO_ALLOC(gif->SHeight, stride)) {
-        return 0;
+/*
+ * Reads records up to and including the descriptor of the next image.
+ * Returns 1 if an image follows, 0 at the end of the stream or on error.
+ */
+static int
+SplashGifReadToImage(Splash * splash, SplashGifDecoder * dec)
+{
+    GifRecordType recordType;
+
+    for (;;) {
+        if (DGifGetRecordType(dec->gif, &recordType) == GIF_ERROR) {
+            return 0;
+        }
+        switch (recordType) {
+        case IMAGE_DESC_RECORD_TYPE:
+            return DGifGetImageDesc(dec->gif) != GIF_ERROR;
+        case EXTENSION_RECORD_TYPE:
+            if (!SplashGifReadExtension(splash, dec)) {
+                return 0;
+            }
+            break;
+        case TERMINATE_RECORD_TYPE:
+            return 0;
+        default:
+            break;
+        }
     }
+}
 
-    if (!SAFE_TO_ALLOC(gif->ImageCount, sizeof(SplashImage*))) {
+/*
+ * Decodes the image whose descriptor has been read, composes it over the
+ * logical screen and appends the result as a new frame.
+ */
+static int
+SplashGifDecodeFrame(Splash * splash, SplashGifDecoder * dec)
+{
+    GifFileType *gif = dec->gif;
+    GifImageDesc *desc = &gif->Image;
+    ColorMapObject *colorMap = desc->ColorMap ? desc->ColorMap : gif->SColorMap;
+    int stride = dec->stride;
+    int bufferSize = dec->bufferSize;
+    byte_t *pBitmapBits = dec->pBitmapBits;
+    byte_t *pOldBitmapBits = dec->pOldBitmapBits;
+    int transparentColor = dec->transparentColor;
+    int colorCount = 0;
+    rgbquad_t colorMapBuf[SPLASH_COLOR_MAP_SIZE];
+    SplashImage *frame;
+    int i, j;
+    int cx, cy, cw, ch; /* clamped coordinates */
+    const int interlacedOffset[] = { 0, 4, 2, 1, 0 };   /* The way Interlaced image should. */
+    const int interlacedJumps[] = { 8, 8, 4, 2, 1 };    /* be read - offsets and jumps... */
+
+    if (desc->Width <= 0 || desc->Height <= 0 ||
+        !SAFE_TO_ALLOC(desc->Width, desc->Height)) {
         return 0;
     }
-    bufferSize = stride * gif->SHeight;
-    pBitmapBits = (byte_t *) malloc(bufferSize);
-    if (!pBitmapBits) {
-        return 0;
+    if (desc->Width * desc->Height > dec->rasterSize) {
+        GifPixelType *pRaster = (GifPixelType *)
+            realloc(dec->pRaster, desc->Width * desc->Height);
+        if (!pRaster) {
+            return 0;
+        }
+        dec->pRaster = pRaster;
+        dec->rasterSize = desc->Width * desc->Height;
     }
-    pOldBitmapBits = (byte_t *) malloc(bufferSize);
-    if (!pOldBitmapBits) {
-        free(pBitmapBits);
+    /* the raster is read as stored, interlaced images are handled below */
+    if (DGifGetLine(gif, dec->pRaster, desc->Width * desc->Height) == GIF_ERROR) {
         return 0;
     }
-    memset(pBitmapBits, 0, bufferSize);
 
-    splash->width = gif->SWidth;
-    splash->height = gif->SHeight;
-    splash->frameCount = gif->ImageCount;
-    splash->frames = (SplashImage *)
-        SAFE_SIZE_ARRAY_ALLOC(malloc, sizeof(SplashImage), gif->ImageCount);
-    if (!splash->frames) {
-      free(pBitmapBits);
-      free(pOldBitmapBits);
-      return 0;
-    }
-    memset(splash->frames, 0, sizeof(SplashImage) * gif->ImageCount);
-    splash->loopCount = 1;
+    cx = FIX_POINT(desc->Left, 0, gif->SWidth);
+    cy = FIX_POINT(desc->Top, 0, gif->SHeight);
+    cw = FIX_LENGTH(desc->Left, desc->Width, gif->SWidth);
+    ch = FIX_LENGTH(desc->Top, desc->Height, gif->SHeight);
 
-    for (imageIndex = 0; imageIndex < gif->ImageCount; imageIndex++) {
-        SavedImage *image = &(gif->SavedImages[imageIndex]);
-        GifImageDesc *desc = &(image->ImageDesc);
-        ColorMapObject *colorMap =
-            desc->ColorMap ? desc->ColorMap : gif->SColorMap;
-
-        int transparentColor = -1;
-        int frameDelay = 100;
-        int disposeMethod = GIF_DISPOSE_RESTORE;
-        int colorCount = 0;
-        rgbquad_t colorMapBuf[SPLASH_COLOR_MAP_SIZE];
-
-        cx = FIX_POINT(desc->Left, 0, gif->SWidth);
-        cy = FIX_POINT(desc->Top, 0, gif->SHeight);
-        cw = FIX_LENGTH(desc->Left, desc->Width, gif->SWidth);
-        ch = FIX_LENGTH(desc->Top, desc->Height, gif->SHeight);
-
-        if (colorMap) {
-            if (colorMap->ColorCount <= SPLASH_COLOR_MAP_SIZE) {
-                colorCount = colorMap->ColorCount;
-            } else  {
-                colorCount = SPLASH_COLOR_MAP_SIZE;
-            }
+    if (colorMap) {
+        if (colorMap->ColorCount <= SPLASH_COLOR_MAP_SIZE) {
+            colorCount = colorMap->ColorCount;
+        } else  {
+            colorCount = SPLASH_COLOR_MAP_SIZE;
         }
-
-        /* the code below is loosely based around gif extension processing from win32 libungif sample */
-
-        for (i = 0; i < image->ExtensionBlockCount; i++) {
-            byte_t *pExtension = (byte_t *) image->ExtensionBlocks[i].Bytes;
-            unsigned size = image->ExtensionBlocks[i].ByteCount;
-
-            switch (image->ExtensionBlocks[i].Function) {
-            case GRAPHICS_EXT_FUNC_CODE:
-                {
-                    int flag = pExtension[0];
-
-                    frameDelay = (((int)pExtension[2]) << 8) | pExtension[1];
-                    if (frameDelay < 10)
-                        frameDelay = 10;
-                    if (flag & GIF_TRANSPARENT) {
-                        transparentColor = pExtension[3];
-                    } else {
-                        transparentColor = GIF_NOT_TRANSPARENT;
-                    }
-                    disposeMethod =
-                        (flag >> GIF_DISPOSE_SHIFT) & GIF_DISPOSE_MASK;
-                    break;
-                }
-            case APPLICATION_EXT_FUNC_CODE:
-                {
-                    if (size == sizeof(szNetscape20ext)
-                        && memcmp(pExtension, szNetscape20ext, size) == 0) {
-                        int iSubCode;
-
-                        if (++i >= image->ExtensionBlockCount)
-                            break;
-                        pExtension = (byte_t *) image->ExtensionBlocks[i].Bytes;
-                        if (image->ExtensionBlocks[i].ByteCount != 3)
-                            break;
-                        iSubCode = pExtension[0] & 0x07;
-                        if (iSubCode == NSEXT_LOOP) {
-                            splash->loopCount =
-                                (pExtension[1] | (((int)pExtension[2]) << 8)) - 1;
-                        }
-                    }
-                    break;
-                }
-            default:
-                break;
-            }
+        for (i = 0; i < colorCount; i++) {
+            colorMapBuf[i] = MAKE_QUAD_GIF(colorMap->Colors[i], 0xff);
         }
+    }
+    {
 
-        if (colorMap) {
-            for (i = 0; i < colorCount; i++) {
-                colorMapBuf[i] = MAKE_QUAD_GIF(colorMap->Colors[i], 0xff);
-            }
-        }
-        {
+        byte_t *pSrc = dec->pRaster;
+        ImageFormat srcFormat;
+        ImageRect srcRect, dstRect;
+        int pass = 4, npass = 5;
 
-            byte_t *pSrc = image->RasterBits;
-            ImageFormat srcFormat;
-            ImageRect srcRect, dstRect;
-            int pass = 4, npass = 5;
-
-#if GIFLIB_MAJOR < 5
-            /* Interlaced gif support is broken in giflib < 5
-               so we need to work around this */
-            if (desc->Interlace) {
-                pass = 0;
-                npass = 4;
-            }
-#endif
+        if (desc->Interlace) {
+            pass = 0;
+            npass = 4;
+        }
 
-            srcFormat.colorMap = colorMapBuf;
-            srcFormat.depthBytes = 1;
-            srcFormat.byteOrder = BYTE_ORDER_NATIVE;
-            srcFormat.transparentColor = transparentColor;
-            srcFormat.fixedBits = QUAD_ALPHA_MASK;      // fixed 100% alpha
-            srcFormat.premultiplied = 0;
-
-            for (; pass < npass; ++pass) {
-                int jump = interlacedJumps[pass];
-                int ofs = interlacedOffset[pass];
-                /* Number of source lines for current pass */
-                int numPassLines = (desc->Height + jump - ofs - 1) / jump;
-                /* Number of lines that fits to dest buffer */
-                int numLines = (ch + jump - ofs - 1) / jump;
-
-                initRect(&srcRect, 0, 0, desc->Width, numLines, 1,
-                    desc->Width, pSrc, &srcFormat);
-
-                if (numLines > 0) {
-                    initRect(&dstRect, cx, cy + ofs, cw,
-                             numLines , jump, stride, pBitmapBits, &splash->imageFormat);
-
-                    pSrc += convertRect(&srcRect, &dstRect, CVT_ALPHATEST);
-                }
-                // skip extra source data
-                pSrc += (numPassLines - numLines) * srcRect.stride;
+        srcFormat.colorMap = colorMapBuf;
+        srcFormat.depthBytes = 1;
+        srcFormat.byteOrder = BYTE_ORDER_NATIVE;
+        srcFormat.transparentColor = transparentColor;
+        srcFormat.fixedBits = QUAD_ALPHA_MASK;      // fixed 100% alpha
+        srcFormat.premultiplied = 0;
+
+        for (; pass < npass; ++pass) {
+            int jump = interlacedJumps[pass];
+            int ofs = interlacedOffset[pass];
+            /* Number of source lines for current pass */
+            int numPassLines = (desc->Height + jump - ofs - 1) / jump;
+            /* Number of lines that fits to dest buffer */
+            int numLines = (ch + jump - ofs - 1) / jump;
+
+            initRect(&srcRect, 0, 0, desc->Width, numLines, 1,
+                desc->Width, pSrc, &srcFormat);
+
+            if (numLines > 0) {
+                initRect(&dstRect, cx, cy + ofs, cw,
+                         numLines , jump, stride, pBitmapBits, &splash->imageFormat);
+
+                pSrc += convertRect(&srcRect, &dstRect, CVT_ALPHATEST);
             }
+            // skip extra source data
+            pSrc += (numPassLines - numLines) * srcRect.stride;
         }
+    }
 
-        // now dispose of the previous frame correctly
+    // now dispose of the previous frame correctly
 
-        splash->frames[imageIndex].bitmapBits =
-            (rgbquad_t *) malloc(bufferSize); // bufferSize is safe (checked above)
-        if (!splash->frames[imageIndex].bitmapBits) {
-            free(pBitmapBits);
-            free(pOldBitmapBits);
-            /* Assuming that callee will take care of splash frames we have already allocated */
-            return 0;
-        }
-        memcpy(splash->frames[imageIndex].bitmapBits, pBitmapBits, bufferSize);
-
-        SplashInitFrameShape(splash, imageIndex);
+    frame = SplashAddFrame(splash);
+    if (!frame) {
+        return 0;
+    }
+    frame->bitmapBits =
+        (rgbquad_t *) malloc(bufferSize); // bufferSize is safe (checked above)
+    if (!frame->bitmapBits) {
+        splash->frameCount--;
+        return 0;
+    }
+    memcpy(frame->bitmapBits, pBitmapBits, bufferSize);
+
+    SplashInitFrameShape(splash, splash->frameCount - 1);
+
+    frame->delay = dec->frameDelay * 10;     // 100ths of second to milliseconds
+    switch (dec->disposeMethod) {
+    case GIF_DISPOSE_LEAVE:
+        memcpy(pOldBitmapBits, pBitmapBits, bufferSize);
+        break;
+    case GIF_DISPOSE_NONE:
+        break;
+    case GIF_DISPOSE_BACKGND:
+        {
+            ImageRect dstRect;
+            rgbquad_t fillColor = 0;                        // 0 is transparent
 
-        splash->frames[imageIndex].delay = frameDelay * 10;     // 100ths of second to milliseconds
-        switch (disposeMethod) {
-        case GIF_DISPOSE_LEAVE:
-            memcpy(pOldBitmapBits, pBitmapBits, bufferSize);
-            break;
-        case GIF_DISPOSE_NONE:
-            break;
-        case GIF_DISPOSE_BACKGND:
-            {
-                ImageRect dstRect;
-                rgbquad_t fillColor = 0;                        // 0 is transparent
-
-                if (transparentColor < 0) {
-                    fillColor= MAKE_QUAD_GIF(
-                        colorMap->Colors[gif->SBackGroundColor], 0xff);
-                }
-                initRect(&dstRect,
-                         cx, cy, cw, ch,
-                         1, stride,
-                         pBitmapBits, &splash->imageFormat);
-                fillRect(fillColor, &dstRect);
+            if (transparentColor < 0 && colorMap &&
+                gif->SBackGroundColor < colorMap->ColorCount) {
+                fillColor= MAKE_QUAD_GIF(
+                    colorMap->Colors[gif->SBackGroundColor], 0xff);
             }
-            break;
-        case GIF_DISPOSE_RESTORE:
-            {
-                int lineSize = cw * splash->imageFormat.depthBytes;
-                if (lineSize > 0) {
-                    int lineOffset = cx * splash->imageFormat.depthBytes;
-                    int lineIndex = cy * stride + lineOffset;
-                    for (j=0; j<ch; j++) {
-                        memcpy(pBitmapBits + lineIndex, pOldBitmapBits + lineIndex,
-                               lineSize);
-                        lineIndex += stride;
-                    }
+            initRect(&dstRect,
+                     cx, cy, cw, ch,
+                     1, stride,
+                     pBitmapBits, &splash->imageFormat);
+            fillRect(fillColor, &dstRect);
+        }
+        break;
+    case GIF_DISPOSE_RESTORE:
+        {
+            int lineSize = cw * splash->imageFormat.depthBytes;
+            if (lineSize > 0) {
+                int lineOffset = cx * splash->imageFormat.depthBytes;
+                int lineIndex = cy * stride + lineOffset;
+                for (j=0; j<ch; j++) {
+                    memcpy(pBitmapBits + lineIndex, pOldBitmapBits + lineIndex,
+                           lineSize);
+                    lineIndex += stride;
                 }
             }
-            break;
         }
+        break;
     }
 
-    free(pBitmapBits);
-    free(pOldBitmapBits);
+    SplashGifResetControl(dec);
+    return 1;
+}
 
+static void
+SplashGifFreeDecoder(SplashGifDecoder * dec)
+{
+    if (dec->gif) {
 #if GIFLIB_MAJOR > 5 || (GIFLIB_MAJOR == 5 && GIFLIB_MINOR >= 1)
-    if (DGifCloseFile(gif, NULL) == GIF_ERROR) {
-        return 0;
-    }
+        DGifCloseFile(dec->gif, NULL);
 #else
-    DGifCloseFile(gif);
+        DGifCloseFile(dec->gif);
 #endif
+    }
+    free(dec->pBitmapBits);
+    free(dec->pOldBitmapBits);
+    free(dec->pRaster);
+    free(dec);
+}
 
+static int
+SplashGifDecodeNextFrame(Splash * splash)
+{
+    SplashGifDecoder *dec = (SplashGifDecoder *) splash->decoder;
+
+    if (!SplashGifDecodeFrame(splash, dec)) {
+        return 0;
+    }
+    if (!SplashGifReadToImage(splash, dec)) {
+        /* that was the last frame */
+        SplashCloseDecoder(splash);
+    }
     return 1;
 }
 
+static void
+SplashGifCloseDecoder(Splash * splash)
+{
+    SplashGifDecoder *dec = (SplashGifDecoder *) splash->decoder;
+
+    dec->stream.close(&dec->stream);
+    SplashGifFreeDecoder(dec);
+}
+
+/*
+ * Decodes the first frame of the GIF.  If the GIF is animated, the decoder
+ * keeps the stream and is left in splash->decoder, so that the splash screen
+ * can be shown without waiting for the other frames to be decoded.
+ */
+int
+SplashDecodeGif(Splash * splash, GifFileType * gif, SplashStream * stream)
+{
+    SplashGifDecoder *dec;
+
+    SplashCleanup(splash);
+
+    dec = (SplashGifDecoder *) calloc(1, sizeof(SplashGifDecoder));
+    if (!dec) {
+        goto fail;
+    }
+    dec->gif = gif;
+    SplashGifResetControl(dec);
+
+    if (!SAFE_TO_ALLOC(gif->SWidth, splash->imageFormat.depthBytes)) {
+        goto fail;
+    }
+    dec->stride = gif->SWidth * splash->imageFormat.depthBytes;
+    if (splash->byteAlignment > 1)
+        dec->stride =
+            (dec->stride + splash->byteAlignment - 1) & ~(splash->byteAlignment - 1);
+
+    if (!SAFE_TO_ALLOC(gif->SHeight, dec->stride)) {
+        goto fail;
+    }
+
+    dec->bufferSize = dec->stride * gif->SHeight;
+    dec->pBitmapBits = (byte_t *) malloc(dec->bufferSize);
+    if (!dec->pBitmapBits) {
+        goto fail;
+    }
+    dec->pOldBitmapBits = (byte_t *) malloc(dec->bufferSize);
+    if (!dec->pOldBitmapBits) {
+        goto fail;
+    }
+    memset(dec->pBitmapBits, 0, dec->bufferSize);
+
+    splash->width = gif->SWidth;
+    splash->height = gif->SHeight;
+    splash->loopCount = 1;
+
+    if (!SplashGifReadToImage(splash, dec) ||
+        !SplashGifDecodeFrame(splash, dec)) {
+        goto fail;
+    }
+
+    if (SplashGifReadToImage(splash, dec) &&
+        SplashStreamDetach(stream, &dec->stream)) {
+        gif->UserData = &dec->stream;
+        splash->decoder = dec;
+        splash->decodeNextFrame = SplashGifDecodeNextFrame;
+        splash->closeDecoder = SplashGifCloseDecoder;
+    } else {
+        SplashGifFreeDecoder(dec);
+    }
+    return 1;
+
+fail:
+    /* Assuming that callee will take care of splash frames we have already allocated */
+    if (dec) {
+        SplashGifFreeDecoder(dec);
+    } else {
+#if GIFLIB_MAJOR > 5 || (GIFLIB_MAJOR == 5 && GIFLIB_MINOR >= 1)
+        DGifCloseFile(gif, NULL);
+#else
+        DGifCloseFile(gif);
+#endif
+    }
+    return 0;
+}
+
 int
 SplashDecodeGifStream(Splash * splash, SplashStream * stream)
 {
@@ -332,5 +472,5 @@ SplashDecodeGifStream(Splash * splash, SplashStream * stream)
 
     if (!gif)
         return 0;
-    return SplashDecodeGif(splash, gif);
+    return SplashDecodeGif(splash, gif, stream);
 }
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2005, 2019, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2005, 2026, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -89,7 +89,9 @@ SplashCleanup(Splash * splash)
     int i;
 
     splash->currentFrame = -1;
+    SplashCloseDecoder(splash);
     SplashCleanupPlatform(splash);
+    SplashInvalidateScreenData(splash);
     if (splash->frames) {
         for (i = 0; i < splash->frameCount; i++) {
             if (splash->frames[i].bitmapBits) {
@@ -100,6 +102,12 @@ SplashCleanup(Splash * splash)
         free(splash->frames);
         splash->frames = NULL;
     }
+    splash->frameCount = 0;
+    splash->framesCapacity = 0;
+    if (splash->screenScratch) {
+        free(splash->screenScratch);
+        splash->screenScratch = NULL;
+    }
     if (splash->overlayData) {
         free(splash->overlayData);
         splash->overlayData = NULL;
@@ -128,32 +136,63 @@ SplashIsStillLooping(Splash * splash)
         return 0;
     }
     return splash->loopCount != 1 ||
-        splash->currentFrame + 1 < splash->frameCount;
+        splash->currentFrame + 1 < splash->frameCount ||
+        splash->decoder != NULL;
 }
 
+/*
+ * Converts the current frame to the screen format.  The converted frames
+ * are kept in the frame descriptors, up to SPLASH_SCREEN_CACHE_LIMIT
+ * bytes, so that a looping animation is converted only once.  The cache
+ * must be invalidated whenever the overlay image changes.
+ */
 void
 SplashUpdateScreenData(Splash * splash)
 {
     ImageRect srcRect, dstRect;
+    SplashImage *frame;
+    size_t size;
+    void *bits;
+
     if (splash->currentFrame < 0) {
         return;
     }
+    frame = &splash->frames[splash->currentFrame];
+    if (frame->screenBits) {
+        splash->screenData = frame->screenBits;
+        return;
+    }
 
     initRect(&srcRect, 0, 0, splash->width, splash->height, 1,
         splash->width * sizeof(rgbquad_t),
-        splash->frames[splash->currentFrame].bitmapBits, &splash->imageFormat);
-    if (splash->screenData) {
-        free(splash->screenData);
-    }
+        frame->bitmapBits, &splash->imageFormat);
     splash->screenStride = splash->width * splash->screenFormat.depthBytes;
     if (splash->byteAlignment > 1) {
         splash->screenStride =
             (splash->screenStride + splash->byteAlignment - 1) &
             ~(splash->byteAlignment - 1);
     }
-    splash->screenData = malloc(splash->height * splash->screenStride);
+    size = (size_t)splash->height * splash->screenStride;
+    bits = NULL;
+    if (splash->screenCacheSize + size <= SPLASH_SCREEN_CACHE_LIMIT) {
+        bits = malloc(size);
+        if (bits) {
+            frame->screenBits = bits;
+            splash->screenCacheSize += size;
+        }
+    }
+    if (!bits) {
+        if (!splash->screenScratch) {
+            splash->screenScratch = malloc(size);
+        }
+        bits = splash->screenScratch;
+    }
+    splash->screenData = bits;
+    if (!bits) {
+        return;
+    }
     initRect(&dstRect, 0, 0, splash->width, splash->height, 1,
-        splash->screenStride, splash->screenData, &splash->screenFormat);
+        splash->screenStride, bits, &splash->screenFormat);
     if (splash->overlayData) {
         convertRect2(&srcRect, &dstRect, CVT_BLEND, &splash->overlayRect);
     }
@@ -162,6 +201,23 @@ SplashUpdateScreenData(Splash * splash)
     }
 }
 
+void
+SplashInvalidateScreenData(Splash * splash)
+{
+    int i;
+
+    if (splash->frames) {
+        for (i = 0; i < splash->frameCount; i++) {
+            if (splash->frames[i].screenBits) {
+                free(splash->frames[i].screenBits);
+                splash->frames[i].screenBits = NULL;
+            }
+        }
+    }
+    splash->screenCacheSize = 0;
+    splash->screenData = NULL;
+}
+
 void
 SplashNextFrame(Splash * splash)
 {
@@ -173,7 +229,8 @@ SplashNextFrame(Splash * splash)
             return;
         }
         splash->time += splash->frames[splash->currentFrame].delay;
-        if (++splash->currentFrame >= splash->frameCount) {
+        if (++splash->currentFrame >= splash->frameCount &&
+                !SplashDecodeNextFrame(splash)) {
             splash->currentFrame = 0;
             if (splash->loopCount > 0) {
                 splash->loopCount--;
@@ -183,6 +240,70 @@ SplashNextFrame(Splash * splash)
         SplashTime() <= 0);
 }
 
+/*
+ * Appends a zeroed frame descriptor, growing the frame array as needed.
+ * Returns NULL if out of memory.
+ */
+SplashImage *
+SplashAddFrame(Splash * splash)
+{
+    SplashImage *frame;
+
+    if (splash->frameCount >= splash->framesCapacity) {
+        int capacity = splash->framesCapacity ? splash->framesCapacity * 2 : 8;
+        SplashImage *frames;
+
+        if (!SAFE_TO_ALLOC(capacity, sizeof(SplashImage))) {
+            return NULL;
+        }
+        frames = (SplashImage *) realloc(splash->frames,
+            capacity * sizeof(SplashImage));
+        if (!frames) {
+            return NULL;
+        }
+        splash->frames = frames;
+        splash->framesCapacity = capacity;
+    }
+    frame = &splash->frames[splash->frameCount++];
+    memset(frame, 0, sizeof(SplashImage));
+    return frame;
+}
+
+/*
+ * Animations are decoded lazily: the decoder only decodes the first frame
+ * before the splash screen is shown and leaves its state in splash->decoder.
+ * The remaining frames are decoded by the splash screen thread when the
+ * animation first reaches them.  Returns 1 if a frame was appended, or 0 if
+ * there are no more frames, in which case the decoder has been closed.
+ * Must be called under the splash lock.
+ */
+int
+SplashDecodeNextFrame(Splash * splash)
+{
+    int frameCount = splash->frameCount;
+
+    if (!splash->decoder || !splash->decodeNextFrame) {
+        return 0;
+    }
+    if (!splash->decodeNextFrame(splash) ||
+            splash->frameCount <= frameCount) {
+        SplashCloseDecoder(splash);
+        return 0;
+    }
+    return 1;
+}
+
+void
+SplashCloseDecoder(Splash * splash)
+{
+    if (splash->decoder && splash->closeDecoder) {
+        splash->closeDecoder(splash);
+    }
+    splash->decoder = NULL;
+    splash->decodeNextFrame = NULL;
+    splash->closeDecoder = NULL;
+}
+
 int
 BitmapToYXBandedRectangles(ImageRect * pSrcRect, RECT_T * out)
 {
@@ -377,6 +498,14 @@ static int peekMem(void* pStream) {
 }
 
 static void closeMem(void* pStream) {
+    unsigned char* pOwned = ((SplashStream*)pStream)->arg.mem.pOwned;
+    if (pOwned) {
+        free(pOwned);
+        ((SplashStream*)pStream)->arg.mem.pOwned = NULL;
+    }
+}
+
+static void closeDetached(void* pStream) {
 }
 
 int SplashStreamInitFile(SplashStream * pStream, const char* filename) {
@@ -390,12 +519,40 @@ int SplashStreamInitFile(SplashStream * pStream, const char* filename) {
 int SplashStreamInitMemory(SplashStream * pStream, void* pData, int size) {
     pStream->arg.mem.pData = (unsigned char*)pData;
     pStream->arg.mem.pDataEnd = (unsigned char*)pData + size;
+    pStream->arg.mem.pOwned = NULL;
     pStream->read = readMem;
     pStream->peek = peekMem;
     pStream->close = closeMem;
     return 1;
 }
 
+/*
+ * Moves the stream to a new owner so that a decoder can keep reading it
+ * after SplashLoadStream returns.  Memory streams are backed by the
+ * caller's buffer, so the unread part of the data is copied.  Closing the
+ * original stream afterwards does nothing.
+ */
+int SplashStreamDetach(SplashStream * pStream, SplashStream * pDetached) {
+    *pDetached = *pStream;
+    if (pStream->read == readMem) {
+        unsigned char* pSrc = pStream->arg.mem.pData;
+        size_t size = pStream->arg.mem.pDataEnd - pSrc;
+        unsigned char* pCopy = (unsigned char*)malloc(size > 0 ? size : 1);
+        if (!pCopy) {
+            return 0;
+        }
+        memcpy(pCopy, pSrc, size);
+        if (pStream->arg.mem.pOwned) {
+            free(pStream->arg.mem.pOwned);
+        }
+        pDetached->arg.mem.pData = pCopy;
+        pDetached->arg.mem.pDataEnd = pCopy + size;
+        pDetached->arg.mem.pOwned = pCopy;
+    }
+    pStream->close = closeDetached;
+    return 1;
+}
+
 JNIEXPORT int
 SplashGetScaledImgNameMaxPstfixLen(const char *fileName){
     return strlen(fileName) + strlen("@100pct") + 1;
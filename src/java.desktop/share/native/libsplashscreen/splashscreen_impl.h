@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2005, 2019, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2005, 2026, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -57,6 +57,7 @@ SplashGetScaledImgNameMaxPstfixLen(const char*);
 typedef struct SplashImage
 {
     rgbquad_t *bitmapBits;
+    void *screenBits;           /* bitmapBits converted to the screen format, NULL if not cached                            */
     int delay;                  /* before next image display, in msec                                                       */
 #if defined(WITH_WIN32)
     HRGN hRgn;
@@ -78,13 +79,19 @@ typedef struct Splash
     int maskRequired;           /* must be preset before image decoding */
     int width;                  /* in pixels */
     int height;                 /* in pixels */
-    int frameCount;
+    int frameCount;             /* number of frames decoded so far */
+    int framesCapacity;         /* number of allocated frame descriptors */
     SplashImage *frames;        /* dynamically allocated array of frame descriptors */
+    void *decoder;              /* state of an animation still being decoded, NULL once all frames are decoded */
+    int (*decodeNextFrame)(struct Splash *splash);
+    void (*closeDecoder)(struct Splash *splash);
     unsigned time;              /* in msec, origin is not important */
     rgbquad_t *overlayData;     /* overlay image data, always rgbquads */
     ImageRect overlayRect;
     ImageFormat overlayFormat;
-    void *screenData;
+    void *screenData;           /* current frame in the screen format, points to a frame's screenBits or to screenScratch */
+    void *screenScratch;        /* conversion buffer for frames which are not cached */
+    size_t screenCacheSize;     /* total size of the cached screenBits, in bytes */
     int screenStride;           /* stored scanline length in bytes */
     int currentFrame;           // currentFrame==-1 means image is not loaded
     int loopCount;
@@ -152,6 +159,11 @@ void SplashStart(Splash * splash);
 void SplashDone(Splash * splash);
 
 void SplashUpdateScreenData(Splash * splash);
+void SplashInvalidateScreenData(Splash * splash);
+
+SplashImage *SplashAddFrame(Splash * splash);
+int SplashDecodeNextFrame(Splash * splash);
+void SplashCloseDecoder(Splash * splash);
 
 void SplashCleanup(Splash * splash);
 
@@ -169,12 +181,14 @@ typedef struct SplashStream {
         struct {
             unsigned char* pData;
             unsigned char* pDataEnd;
+            unsigned char* pOwned;  /* copy of the data freed on close, or NULL */
         } mem;
     } arg;
 } SplashStream;
 
 int SplashStreamInitFile(SplashStream * stream, const char* filename);
 int SplashStreamInitMemory(SplashStream * stream, void * pData, int size);
+int SplashStreamDetach(SplashStream * stream, SplashStream * detached);
 
 /* image decoding */
 int SplashDecodeGifStream(Splash * splash, SplashStream * stream);
@@ -189,6 +203,12 @@ int BitmapToYXBandedRectangles(ImageRect * pSrcRect, RECT_T * out);
     (((c) > 0) && ((sz) > 0) &&                                            \
      ((0xffffffffu / ((unsigned int)(c))) > (unsigned int)(sz)))
 
+/*
+ * Upper bound for the frames kept converted to the screen format.  Frames
+ * beyond the limit are converted again every time they are displayed.
+ */
+#define SPLASH_SCREEN_CACHE_LIMIT (64 * 1024 * 1024)
+
 #define dbgprintf printf
 
 #endif
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2005, 2011, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2005, 2026, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -149,6 +149,7 @@ SplashDecodePng(Splash * splash, png_rw_ptr read_func, void *io_ptr)
     if (splash->frames == NULL) {
         goto done;
     }
+    memset(splash->frames, 0, sizeof(SplashImage) * splash->frameCount);
 
     splash->loopCount = 1;
     splash->frames[0].bitmapBits = malloc(stride * splash->height);
@@ -0,0 +1,1076 @@
+/*
+ * Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+/*
+ * Append-only, memory-mapped store for FileSystemPreferences.
+ *
+ * All changes to a preferences tree are appended to one log file as
+ * records. The file is mapped shared by every VM using it, so readers
+ * just follow the records appended since they last looked and never
+ * take a lock. Appending is lock-free as well: a writer claims the
+ * first free slot by atomically changing its length word from zero to
+ * the length of its record (with RECORD_PENDING set), fills the record
+ * in and then clears RECORD_PENDING. Because a slot is only claimed
+ * with its length, the claimed records always form a chain that can be
+ * walked even past writers that died half way.
+ *
+ * Compaction rewrites the live records to a new file which is renamed
+ * over the log. It is serialized with a lock on a byte of the file
+ * (released by the kernel if the compactor dies) and stops appends to
+ * the old file by claiming the first free slot with RECORD_SEAL. Users
+ * of the old file notice the seal or the superseded flag and reopen.
+ *
+ * File layout:
+ *
+ *     LogHeader
+ *     records, each aligned to RECORD_ALIGNMENT:
+ *         LogRecord
+ *         char[nodeLen]   node path, modified UTF-8
+ *         char[keyLen]    key, modified UTF-8
+ *         char[valueLen]  value, modified UTF-8
+ *
+ * Record operations are:
+ *
+ *     'N'  node was created
+ *     'P'  key of node was set to value
+ *     'R'  key of node was removed
+ *     'D'  node and all its descendants were removed
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <time.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include <sys/types.h>
+#include "jni_util.h"
+#include "java_util_prefs_FileSystemPreferencesLog.h"
+
+#define LOG_MAGIC               "JPRFLOG1"
+#define LOG_MAGIC_SIZE          8
+#define LOG_INITIAL_SIZE        (64 * 1024)
+#define LOG_MAX_SIZE            ((uint64_t)1 << 30)
+
+/* Compact on request only once the log is at least this large */
+#define LOG_COMPACT_MIN_SIZE    (256 * 1024)
+
+/* Locked bytes of the log file */
+#define LOCK_GROW               0
+#define LOCK_COMPACT            1
+
+#define RECORD_ALIGNMENT        8
+#define RECORD_PENDING          0x80000000U
+#define RECORD_SEAL             0xFFFFFFFFU
+#define RECORD_MAX_SIZE         (16 * 1024 * 1024)
+
+/* How long a compactor waits for pending records before dropping them */
+#define PENDING_TIMEOUT_MS      1000
+
+#define OP_NODE                 'N'
+#define OP_PUT                  'P'
+#define OP_REMOVE               'R'
+#define OP_REMOVE_NODE          'D'
+
+typedef struct {
+    char magic[LOG_MAGIC_SIZE];
+    uint64_t id;            /* different for every file */
+    uint64_t tail;          /* hint: no free slot before this offset */
+    uint32_t superseded;    /* set once compacted file replaced this one */
+    uint32_t reserved;
+    char pad[32];
+} LogHeader;
+
+typedef struct {
+    uint32_t length;        /* 0 if the slot is free */
+    uint32_t checksum;      /* over everything after this field */
+    uint32_t valueLen;
+    uint16_t nodeLen;
+    uint16_t keyLen;
+    uint8_t op;
+    uint8_t pad[7];
+} LogRecord;
+
+typedef struct {
+    char* path;
+    int fd;
+    char* base;
+    size_t mapSize;
+    pthread_mutex_t lock;
+} PrefsLog;
+
+#define HEADER(log)             ((LogHeader*)(log)->base)
+#define RECORD_AT(log, offset)  ((LogRecord*)((log)->base + (offset)))
+#define ALIGN_UP(x)             (((x) + RECORD_ALIGNMENT - 1) \
+                                    & ~(uint64_t)(RECORD_ALIGNMENT - 1))
+
+#if defined(_ALLBSD_SOURCE)
+typedef struct flock FLOCK;
+#define SETLK F_SETLK
+#define SETLKW F_SETLKW
+#else
+typedef struct flock64 FLOCK;
+#define SETLK F_SETLK64
+#define SETLKW F_SETLKW64
+#endif
+
+
+static int lockByte(int fd, off_t offset, int type, jboolean wait) {
+    FLOCK fl;
+    int rc;
+
+    memset(&fl, 0, sizeof(fl));
+    fl.l_whence = SEEK_SET;
+    fl.l_start = offset;
+    fl.l_len = 1;
+    fl.l_type = type;
+    do {
+        rc = fcntl(fd, wait ? SETLKW : SETLK, &fl);
+    } while (rc == -1 && errno == EINTR);
+    return rc;
+}
+
+static uint64_t newLogId(void) {
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return ((uint64_t)tv.tv_sec << 32) ^ ((uint64_t)tv.tv_usec << 12)
+        ^ (uint64_t)getpid() ^ ((uint64_t)(uintptr_t)&tv << 20);
+}
+
+static uint32_t recordChecksum(const LogRecord* rec) {
+    /* FNV-1a */
+    const unsigned char* p = (const unsigned char*)&rec->valueLen;
+    const unsigned char* end = (const unsigned char*)rec + sizeof(LogRecord)
+        + rec->nodeLen + rec->keyLen + rec->valueLen;
+    uint32_t hash = 2166136261U;
+    for (; p < end; p++) {
+        hash ^= *p;
+        hash *= 16777619U;
+    }
+    return hash;
+}
+
+static void sleepMillis(long millis) {
+    struct timespec ts;
+    ts.tv_sec = millis / 1000;
+    ts.tv_nsec = (millis % 1000) * 1000000;
+    nanosleep(&ts, NULL);
+}
+
+static void unmapLog(PrefsLog* log) {
+    if (log->base != NULL) {
+        munmap(log->base, log->mapSize);
+        log->base = NULL;
+        log->mapSize = 0;
+    }
+    if (log->fd != -1) {
+        close(log->fd);
+        log->fd = -1;
+    }
+}
+
+/*
+ * Makes sure the mapping covers the first 'size' bytes of the file.
+ * Returns 0 if the file is shorter.
+ */
+static int ensureMapped(PrefsLog* log, uint64_t size) {
+    struct stat st;
+    void* addr;
+
+    if (size <= log->mapSize) {
+        return 1;
+    }
+    if (fstat(log->fd, &st) == -1 || (uint64_t)st.st_size < size
+            || (uint64_t)st.st_size > LOG_MAX_SIZE) {
+        return 0;
+    }
+    addr = mmap(NULL, (size_t)st.st_size, PROT_READ | PROT_WRITE, MAP_SHARED,
+                log->fd, 0);
+    if (addr == MAP_FAILED) {
+        return 0;
+    }
+    munmap(log->base, log->mapSize);
+    log->base = (char*)addr;
+    log->mapSize = (size_t)st.st_size;
+    return 1;
+}
+
+/*
+ * Grows the file so that it is at least 'size' bytes long. Growing is
+ * serialized, so concurrent writers never shrink the file.
+ */
+static int ensureCapacity(PrefsLog* log, uint64_t size) {
+    struct stat st;
+    int ok = 0;
+
+    if (ensureMapped(log, size)) {
+        return 1;
+    }
+    if (size > LOG_MAX_SIZE) {
+        errno = EFBIG;
+        return 0;
+    }
+    if (lockByte(log->fd, LOCK_GROW, F_WRLCK, JNI_TRUE) == -1) {
+        return 0;
+    }
+    if (fstat(log->fd, &st) == 0) {
+        uint64_t newSize = (uint64_t)st.st_size;
+        if (newSize < size) {
+            while (newSize < size) {
+                newSize *= 2;
+            }
+            if (newSize > LOG_MAX_SIZE) {
+                newSize = LOG_MAX_SIZE;
+            }
+            ok = ftruncate(log->fd, (off_t)newSize) == 0;
+        } else {
+            ok = 1;
+        }
+    }
+    lockByte(log->fd, LOCK_GROW, F_UNLCK, JNI_FALSE);
+    return ok && ensureMapped(log, size);
+}
+
+/*
+ * Creates an empty log file unless it already exists. The file is built
+ * aside and linked in place, so nobody sees a partially initialized log.
+ */
+static int createLogFile(const char* path, int permission) {
+    char* tmp;
+    LogHeader header;
+    int fd;
+    int rc = -1;
+    int oldUmask;
+
+    tmp = (char*)malloc(strlen(path) + 32);
+    if (tmp == NULL) {
+        errno = ENOMEM;
+        return -1;
+    }
+    sprintf(tmp, "%s.%ld.new", path, (long)getpid());
+
+    oldUmask = umask(0);
+    fd = open(tmp, O_RDWR | O_CREAT | O_EXCL, permission);
+    umask(oldUmask);
+    if (fd == -1) {
+        free(tmp);
+        return -1;
+    }
+
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, LOG_MAGIC, LOG_MAGIC_SIZE);
+    header.id = newLogId();
+    header.tail = sizeof(LogHeader);
+    if (write(fd, &header, sizeof(header)) == (ssize_t)sizeof(header)
+            && ftruncate(fd, LOG_INITIAL_SIZE) == 0
+            && (link(tmp, path) == 0 || errno == EEXIST)) {
+        rc = 0;
+    }
+    close(fd);
+    unlink(tmp);
+    free(tmp);
+    return rc;
+}
+
+static int openLog(PrefsLog* log, int permission) {
+    struct stat st;
+    int attempt;
+
+    for (attempt = 0; attempt < 3; attempt++) {
+        log->fd = open(log->path, O_RDWR);
+        if (log->fd == -1) {
+            if (errno == ENOENT && createLogFile(log->path, permission) == 0) {
+                continue;
+            }
+            return 0;
+        }
+        if (fcntl(log->fd, F_SETFD, FD_CLOEXEC) == -1
+                || fstat(log->fd, &st) == -1) {
+            unmapLog(log);
+            return 0;
+        }
+        if ((uint64_t)st.st_size < sizeof(LogHeader)
+                || (uint64_t)st.st_size > LOG_MAX_SIZE) {
+            unmapLog(log);
+            errno = EINVAL;
+            return 0;
+        }
+        log->base = (char*)mmap(NULL, (size_t)st.st_size,
+                                PROT_READ | PROT_WRITE, MAP_SHARED,
+                                log->fd, 0);
+        if (log->base == MAP_FAILED) {
+            log->base = NULL;
+            unmapLog(log);
+            return 0;
+        }
+        log->mapSize = (size_t)st.st_size;
+        if (memcmp(HEADER(log)->magic, LOG_MAGIC, LOG_MAGIC_SIZE) != 0) {
+            unmapLog(log);
+            errno = EINVAL;
+            return 0;
+        }
+        return 1;
+    }
+    return 0;
+}
+
+static int reopenLog(PrefsLog* log) {
+    struct stat st;
+    int permission = 0600;
+    if (fstat(log->fd, &st) == 0) {
+        permission = st.st_mode & 0777;
+    }
+    unmapLog(log);
+    return openLog(log, permission);
+}
+
+/*
+ * Returns the length word of the slot at 'offset', or RECORD_SEAL if the
+ * slot lies beyond the end of the file.
+ */
+static uint32_t slotLength(PrefsLog* log, uint64_t offset) {
+    if (!ensureMapped(log, offset + sizeof(uint32_t))) {
+        return RECORD_SEAL;
+    }
+    return __atomic_load_n(&RECORD_AT(log, offset)->length, __ATOMIC_ACQUIRE);
+}
+
+/*
+ * Walks the chain of claimed slots from the tail hint. Returns the offset
+ * of the first free slot, or of the seal.
+ */
+static uint64_t findFreeSlot(PrefsLog* log, uint32_t* length) {
+    uint64_t offset = __atomic_load_n(&HEADER(log)->tail, __ATOMIC_ACQUIRE);
+    uint32_t len;
+
+    for (;;) {
+        len = slotLength(log, offset);
+        if (len == 0 || len == RECORD_SEAL) {
+            break;
+        }
+        offset += len & ~RECORD_PENDING;
+    }
+    *length = len;
+    return offset;
+}
+
+static void advanceTail(PrefsLog* log, uint64_t offset) {
+    uint64_t tail = __atomic_load_n(&HEADER(log)->tail, __ATOMIC_RELAXED);
+    while (tail < offset && !__atomic_compare_exchange_n(&HEADER(log)->tail,
+            &tail, offset, JNI_TRUE, __ATOMIC_RELEASE, __ATOMIC_RELAXED)) {
+    }
+}
+
+/*
+ * Claims a slot for a record of the given size. Returns its offset or 0
+ * if the log is sealed.
+ */
+static uint64_t claimSlot(PrefsLog* log, uint32_t size) {
+    for (;;) {
+        uint32_t len;
+        uint32_t expected = 0;
+        uint64_t offset = findFreeSlot(log, &len);
+
+        if (len == RECORD_SEAL && !ensureMapped(log, offset + sizeof(uint32_t))) {
+            /* End of file, grow and retry */
+            if (!ensureCapacity(log, offset + size + sizeof(uint32_t))) {
+                return 0;
+            }
+            continue;
+        }
+        if (len == RECORD_SEAL || HEADER(log)->superseded) {
+            return 0;
+        }
+        /* Room for the record and the length word of the next one */
+        if (!ensureCapacity(log, offset + size + sizeof(uint32_t))) {
+            return 0;
+        }
+        if (__atomic_compare_exchange_n(&RECORD_AT(log, offset)->length,
+                &expected, size | RECORD_PENDING, JNI_FALSE,
+                __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+            advanceTail(log, offset + size);
+            return offset;
+        }
+    }
+}
+
+/*
+ * Returns non-zero if the record at 'offset' is complete and intact.
+ * Its length word must have been checked already.
+ */
+static int isValidRecord(PrefsLog* log, uint64_t offset, uint32_t len) {
+    const LogRecord* rec = RECORD_AT(log, offset);
+    return len >= sizeof(LogRecord) && len <= RECORD_MAX_SIZE
+        && ensureMapped(log, offset + len)
+        && sizeof(LogRecord) + (uint64_t)rec->nodeLen + rec->keyLen
+            + rec->valueLen <= len
+        && rec->checksum == recordChecksum(rec);
+}
+
+
+/*
+ * Compaction: the live set is a hash table of record offsets keyed by
+ * (node, key) for 'P' records and by node for 'N' records.
+ */
+
+#define SLOT_EMPTY      0
+#define SLOT_DELETED    1
+
+typedef struct {
+    uint64_t* slots;
+    size_t capacity;
+} LiveSet;
+
+static const char* recordNode(const LogRecord* rec) {
+    return (const char*)(rec + 1);
+}
+
+static const char* recordKey(const LogRecord* rec) {
+    return recordNode(rec) + rec->nodeLen;
+}
+
+static uint32_t liveHash(const LogRecord* rec) {
+    const unsigned char* p = (const unsigned char*)recordNode(rec);
+    const unsigned char* end = p + rec->nodeLen
+        + (rec->op == OP_NODE ? 0 : rec->keyLen);
+    uint32_t hash = rec->op == OP_NODE ? 0x9e3779b9U : 2166136261U;
+    for (; p < end; p++) {
+        hash ^= *p;
+        hash *= 16777619U;
+    }
+    return hash;
+}
+
+static int sameEntry(const LogRecord* a, const LogRecord* b) {
+    int aNode = a->op == OP_NODE;
+    int bNode = b->op == OP_NODE;
+    return aNode == bNode && a->nodeLen == b->nodeLen
+        && memcmp(recordNode(a), recordNode(b), a->nodeLen) == 0
+        && (aNode || (a->keyLen == b->keyLen
+            && memcmp(recordKey(a), recordKey(b), a->keyLen) == 0));
+}
+
+/*
+ * Returns the slot holding an entry matching 'rec', or the free slot
+ * where it would go.
+ */
+static uint64_t* findLive(PrefsLog* log, LiveSet* set, const LogRecord* rec) {
+    size_t i = liveHash(rec) & (set->capacity - 1);
+    uint64_t* freeSlot = NULL;
+    for (;;) {
+        uint64_t* slot = &set->slots[i];
+        if (*slot == SLOT_EMPTY) {
+            return freeSlot != NULL ? freeSlot : slot;
+        }
+        if (*slot == SLOT_DELETED) {
+            if (freeSlot == NULL) {
+                freeSlot = slot;
+            }
+        } else if (sameEntry(RECORD_AT(log, *slot), rec)) {
+            return slot;
+        }
+        i = (i + 1) & (set->capacity - 1);
+    }
+}
+
+static int isInSubtree(const LogRecord* rec, const LogRecord* root) {
+    const char* node = recordNode(rec);
+    const char* prefix = recordNode(root);
+    size_t len = root->nodeLen;
+    if (rec->nodeLen < len || memcmp(node, prefix, len) != 0) {
+        return 0;
+    }
+    return rec->nodeLen == len || (len > 0 && prefix[len - 1] == '/')
+        || node[len] == '/';
+}
+
+static int compareOffsets(const void* a, const void* b) {
+    uint64_t x = *(const uint64_t*)a;
+    uint64_t y = *(const uint64_t*)b;
+    return x < y ? -1 : (x > y ? 1 : 0);
+}
+
+/*
+ * Writes live records to a new file and renames it over the log. Called
+ * with LOCK_COMPACT held and the log sealed at 'end'.
+ */
+static int rewriteLog(PrefsLog* log, uint64_t end) {
+    LiveSet set;
+    uint64_t offset;
+    uint64_t* live = NULL;
+    size_t liveCount = 0;
+    size_t count = 0;
+    size_t i;
+    uint64_t liveSize = sizeof(LogHeader);
+    uint64_t fileSize;
+    struct stat st;
+    LogHeader header;
+    char* tmp = NULL;
+    int fd = -1;
+    int ok = 0;
+    long waited = 0;
+
+    /* Wait for writers to finish their records, then count them */
+    for (offset = sizeof(LogHeader); offset < end; ) {
+        uint32_t len = slotLength(log, offset);
+        if ((len & RECORD_PENDING) && len != RECORD_SEAL
+                && waited < PENDING_TIMEOUT_MS) {
+            sleepMillis(1);
+            waited++;
+            continue;
+        }
+        count++;
+        offset += len & ~RECORD_PENDING;
+    }
+
+    set.capacity = 16;
+    while (set.capacity < count * 2) {
+        set.capacity *= 2;
+    }
+    set.slots = (uint64_t*)calloc(set.capacity, sizeof(uint64_t));
+    if (set.slots == NULL) {
+        errno = ENOMEM;
+        return 0;
+    }
+
+    for (offset = sizeof(LogHeader); offset < end; ) {
+        uint32_t len = slotLength(log, offset);
+        LogRecord* rec = RECORD_AT(log, offset);
+        if (!(len & RECORD_PENDING) && isValidRecord(log, offset, len)) {
+            uint64_t* slot;
+            switch (rec->op) {
+            case OP_NODE:
+            case OP_PUT:
+                *findLive(log, &set, rec) = offset;
+                break;
+            case OP_REMOVE:
+                rec->op = OP_PUT;
+                slot = findLive(log, &set, rec);
+                rec->op = OP_REMOVE;
+                if (*slot > SLOT_DELETED) {
+                    *slot = SLOT_DELETED;
+                }
+                break;
+            case OP_REMOVE_NODE:
+                for (i = 0; i < set.capacity; i++) {
+                    if (set.slots[i] > SLOT_DELETED
+                            && isInSubtree(RECORD_AT(log, set.slots[i]), rec)) {
+                        set.slots[i] = SLOT_DELETED;
+                    }
+                }
+                break;
+            }
+        }
+        offset += len & ~RECORD_PENDING;
+    }
+
+    /* Keep the original order of the surviving records */
+    live = (uint64_t*)malloc((count + 1) * sizeof(uint64_t));
+    if (live == NULL) {
+        errno = ENOMEM;
+        goto cleanup;
+    }
+    for (i = 0; i < set.capacity; i++) {
+        if (set.slots[i] > SLOT_DELETED) {
+            live[liveCount++] = set.slots[i];
+            liveSize += RECORD_AT(log, set.slots[i])->length;
+        }
+    }
+    qsort(live, liveCount, sizeof(uint64_t), compareOffsets);
+
+    tmp = (char*)malloc(strlen(log->path) + 32);
+    if (tmp == NULL) {
+        errno = ENOMEM;
+        goto cleanup;
+    }
+    sprintf(tmp, "%s.%ld.compact", log->path, (long)getpid());
+    if (fstat(log->fd, &st) == -1) {
+        goto cleanup;
+    }
+    unlink(tmp);
+    fd = open(tmp, O_WRONLY | O_CREAT | O_EXCL, 0600);
+    if (fd == -1) {
+        goto cleanup;
+    }
+    if (fchmod(fd, st.st_mode & 0777) == -1) {
+        goto cleanup;
+    }
+
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, LOG_MAGIC, LOG_MAGIC_SIZE);
+    header.id = newLogId();
+    header.tail = liveSize;
+    if (write(fd, &header, sizeof(header)) != (ssize_t)sizeof(header)) {
+        goto cleanup;
+    }
+    for (i = 0; i < liveCount; i++) {
+        const LogRecord* rec = RECORD_AT(log, live[i]);
+        const char* p = (const char*)rec;
+        size_t left = rec->length;
+        while (left > 0) {
+            ssize_t n = write(fd, p, left);
+            if (n == -1 && errno == EINTR) {
+                continue;
+            }
+            if (n <= 0) {
+                goto cleanup;
+            }
+            p += n;
+            left -= (size_t)n;
+        }
+    }
+
+    fileSize = LOG_INITIAL_SIZE;
+    while (fileSize < liveSize * 2) {
+        fileSize *= 2;
+    }
+    if (ftruncate(fd, (off_t)fileSize) == -1 || fsync(fd) == -1) {
+        goto cleanup;
+    }
+    if (rename(tmp, log->path) == -1) {
+        goto cleanup;
+    }
+    ok = 1;
+
+cleanup:
+    if (fd != -1) {
+        close(fd);
+    }
+    if (!ok && tmp != NULL) {
+        unlink(tmp);
+    }
+    free(tmp);
+    free(live);
+    free(set.slots);
+    return ok;
+}
+
+/*
+ * Compacts the log if 'force' is set or it has grown large.
+ * Returns 1 if the log was compacted, 0 if not, -1 on error.
+ */
+static int compactLog(PrefsLog* log, jboolean force) {
+    uint64_t end;
+    uint32_t len;
+    int result = 0;
+
+    if (lockByte(log->fd, LOCK_COMPACT, F_WRLCK, JNI_FALSE) == -1) {
+        /* Somebody else is compacting */
+        return 0;
+    }
+
+    if (HEADER(log)->superseded) {
+        lockByte(log->fd, LOCK_COMPACT, F_UNLCK, JNI_FALSE);
+        return reopenLog(log) ? 0 : -1;
+    }
+
+    end = findFreeSlot(log, &len);
+    if (!force && len != RECORD_SEAL && end < LOG_COMPACT_MIN_SIZE) {
+        lockByte(log->fd, LOCK_COMPACT, F_UNLCK, JNI_FALSE);
+        return 0;
+    }
+
+    /* Seal the log, unless a compactor that died did it already */
+    while (len != RECORD_SEAL) {
+        uint32_t expected = 0;
+        if (!ensureCapacity(log, end + sizeof(uint32_t))) {
+            result = -1;
+            goto done;
+        }
+        if (__atomic_compare_exchange_n(&RECORD_AT(log, end)->length,
+                &expected, RECORD_SEAL, JNI_FALSE,
+                __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+            break;
+        }
+        end = findFreeSlot(log, &len);
+    }
+
+    if (rewriteLog(log, end)) {
+        __atomic_store_n(&HEADER(log)->superseded, 1, __ATOMIC_RELEASE);
+        result = 1;
+    } else {
+        result = -1;
+    }
+
+done:
+    lockByte(log->fd, LOCK_COMPACT, F_UNLCK, JNI_FALSE);
+    if (result == 1 && !reopenLog(log)) {
+        result = -1;
+    }
+    return result;
+}
+
+/*
+ * Waits until the sealed log is replaced, finishing the compaction if
+ * the compactor died. Returns 0 on error.
+ */
+static int waitForCompaction(PrefsLog* log) {
+    for (;;) {
+        if (__atomic_load_n(&HEADER(log)->superseded, __ATOMIC_ACQUIRE)) {
+            return reopenLog(log);
+        }
+        if (lockByte(log->fd, LOCK_COMPACT, F_WRLCK, JNI_FALSE) == 0) {
+            /* Nobody is compacting the sealed log: take over */
+            lockByte(log->fd, LOCK_COMPACT, F_UNLCK, JNI_FALSE);
+            if (compactLog(log, JNI_TRUE) < 0) {
+                return 0;
+            }
+            continue;
+        }
+        sleepMillis(1);
+    }
+}
+
+static void throwLogError(JNIEnv* env, PrefsLog* log, const char* what) {
+    char msg[256];
+    snprintf(msg, sizeof(msg), "%s %s", what, log->path);
+    JNU_ThrowIOExceptionWithLastError(env, msg);
+}
+
+/*
+ * Class:     java_util_prefs_FileSystemPreferencesLog
+ * Method:    open0
+ * Signature: (Ljava/lang/String;I)J
+ */
+JNIEXPORT jlong JNICALL
+Java_java_util_prefs_FileSystemPreferencesLog_open0(JNIEnv* env,
+    jclass thisclass, jstring java_fname, jint permission) {
+    const char* fname;
+    PrefsLog* log;
+
+    fname = JNU_GetStringPlatformChars(env, java_fname, NULL);
+    if (fname == NULL) {
+        return 0;
+    }
+    log = (PrefsLog*)calloc(1, sizeof(PrefsLog));
+    if (log == NULL || (log->path = strdup(fname)) == NULL) {
+        free(log);
+        JNU_ReleaseStringPlatformChars(env, java_fname, fname);
+        JNU_ThrowOutOfMemoryError(env, NULL);
+        return 0;
+    }
+    JNU_ReleaseStringPlatformChars(env, java_fname, fname);
+
+    log->fd = -1;
+    if (!openLog(log, permission)) {
+        throwLogError(env, log, "Cannot open preferences log");
+        free(log->path);
+        free(log);
+        return 0;
+    }
+    pthread_mutex_init(&log->lock, NULL);
+    return ptr_to_jlong(log);
+}
+
+/*
+ * Class:     java_util_prefs_FileSystemPreferencesLog
+ * Method:    close0
+ * Signature: (J)V
+ */
+JNIEXPORT void JNICALL
+Java_java_util_prefs_FileSystemPreferencesLog_close0(JNIEnv* env,
+    jclass thisclass, jlong handle) {
+    PrefsLog* log = (PrefsLog*)jlong_to_ptr(handle);
+    if (log != NULL) {
+        unmapLog(log);
+        pthread_mutex_destroy(&log->lock);
+        free(log->path);
+        free(log);
+    }
+}
+
+/*
+ * Appends 'count' records and, if 'sync' is set, flushes them to disk.
+ * Only the pages holding the new records are written, so the cost of
+ * a sync depends on the number of changes rather than on the size of
+ * the preferences tree.
+ *
+ * Class:     java_util_prefs_FileSystemPreferencesLog
+ * Method:    append0
+ * Signature: (J[B[Ljava/lang/String;[Ljava/lang/String;[Ljava/lang/String;IZ)V
+ */
+JNIEXPORT void JNICALL
+Java_java_util_prefs_FileSystemPreferencesLog_append0(JNIEnv* env,
+    jclass thisclass, jlong handle, jbyteArray ops, jobjectArray nodes,
+    jobjectArray keys, jobjectArray values, jint count, jboolean sync) {
+    PrefsLog* log = (PrefsLog*)jlong_to_ptr(handle);
+    jbyte* opBuf;
+    jint i;
+
+    opBuf = (jbyte*)malloc(count > 0 ? (size_t)count : 1);
+    if (opBuf == NULL) {
+        JNU_ThrowOutOfMemoryError(env, NULL);
+        return;
+    }
+    (*env)->GetByteArrayRegion(env, ops, 0, count, opBuf);
+    if ((*env)->ExceptionCheck(env)) {
+        free(opBuf);
+        return;
+    }
+
+    pthread_mutex_lock(&log->lock);
+    for (i = 0; i < count && !(*env)->ExceptionCheck(env); i++) {
+        jstring strs[3];
+        const char* chars[3] = { NULL, NULL, NULL };
+        jsize lens[3] = { 0, 0, 0 };
+        uint64_t size;
+        uint64_t offset;
+        LogRecord* rec;
+        char* p;
+        int j;
+
+        strs[0] = (jstring)(*env)->GetObjectArrayElement(env, nodes, i);
+        strs[1] = (jstring)(*env)->GetObjectArrayElement(env, keys, i);
+        strs[2] = (jstring)(*env)->GetObjectArrayElement(env, values, i);
+        for (j = 0; j < 3 && !(*env)->ExceptionCheck(env); j++) {
+            if (strs[j] != NULL) {
+                lens[j] = (*env)->GetStringUTFLength(env, strs[j]);
+                chars[j] = (*env)->GetStringUTFChars(env, strs[j], NULL);
+            }
+        }
+
+        size = ALIGN_UP(sizeof(LogRecord) + (uint64_t)lens[0] + lens[1]
+                        + lens[2]);
+        if ((*env)->ExceptionCheck(env)) {
+            /* fall through to release */
+        } else if (size > RECORD_MAX_SIZE || lens[0] > 0xFFFF
+                || lens[1] > 0xFFFF) {
+            JNU_ThrowIllegalArgumentException(env, "preference too long");
+        } else {
+            while ((offset = claimSlot(log, (uint32_t)size)) == 0) {
+                if (!waitForCompaction(log)) {
+                    break;
+                }
+            }
+            if (offset == 0) {
+                throwLogError(env, log, "Cannot append to preferences log");
+            } else {
+                rec = RECORD_AT(log, offset);
+                rec->op = (uint8_t)opBuf[i];
+                rec->nodeLen = (uint16_t)lens[0];
+                rec->keyLen = (uint16_t)lens[1];
+                rec->valueLen = (uint32_t)lens[2];
+                memset(rec->pad, 0, sizeof(rec->pad));
+                p = (char*)(rec + 1);
+                for (j = 0; j < 3; j++) {
+                    if (lens[j] > 0) {
+                        memcpy(p, chars[j], (size_t)lens[j]);
+                        p += lens[j];
+                    }
+                }
+                memset(p, 0, (size_t)((char*)rec + size - p));
+                rec->checksum = recordChecksum(rec);
+                __atomic_store_n(&rec->length, (uint32_t)size,
+                                 __ATOMIC_RELEASE);
+
+                if (sync) {
+                    long pageSize = sysconf(_SC_PAGESIZE);
+                    uintptr_t start = (uintptr_t)rec
+                        & ~(uintptr_t)(pageSize - 1);
+                    if (msync((void*)start,
+                            (size_t)((uintptr_t)rec + size - start),
+                            MS_SYNC) == -1) {
+                        throwLogError(env, log, "Cannot sync preferences log");
+                    }
+                }
+            }
+        }
+
+        for (j = 0; j < 3; j++) {
+            if (chars[j] != NULL) {
+                (*env)->ReleaseStringUTFChars(env, strs[j], chars[j]);
+            }
+            if (strs[j] != NULL) {
+                (*env)->DeleteLocalRef(env, strs[j]);
+            }
+        }
+    }
+    pthread_mutex_unlock(&log->lock);
+    free(opBuf);
+}
+
+static jstring newRecordString(JNIEnv* env, const char* chars, size_t len) {
+    char buf[256];
+    char* str = len < sizeof(buf) ? buf : (char*)malloc(len + 1);
+    jstring result;
+    if (str == NULL) {
+        JNU_ThrowOutOfMemoryError(env, NULL);
+        return NULL;
+    }
+    memcpy(str, chars, len);
+    str[len] = '\0';
+    result = (*env)->NewStringUTF(env, str);
+    if (str != buf) {
+        free(str);
+    }
+    return result;
+}
+
+/*
+ * Returns records appended since the last call as an array of strings,
+ * four per record: the operation, node, key and value (null if absent).
+ * state[0] is the offset to continue from and state[1] the id of the
+ * file it refers to. If the log was compacted in the meantime, all the
+ * records of the new file are returned and state[1] changes; the caller
+ * then has to forget what it read before.
+ *
+ * Class:     java_util_prefs_FileSystemPreferencesLog
+ * Method:    read0
+ * Signature: (J[J)[Ljava/lang/String;
+ */
+JNIEXPORT jobjectArray JNICALL
+Java_java_util_prefs_FileSystemPreferencesLog_read0(JNIEnv* env,
+    jclass thisclass, jlong handle, jlongArray state) {
+    PrefsLog* log = (PrefsLog*)jlong_to_ptr(handle);
+    jlong st[2];
+    uint64_t from;
+    uint64_t offset;
+    jsize count = 0;
+    jsize i;
+    jclass stringClass;
+    jobjectArray result = NULL;
+
+    (*env)->GetLongArrayRegion(env, state, 0, 2, st);
+    if ((*env)->ExceptionCheck(env)) {
+        return NULL;
+    }
+
+    pthread_mutex_lock(&log->lock);
+    if (__atomic_load_n(&HEADER(log)->superseded, __ATOMIC_ACQUIRE)
+            && !reopenLog(log)) {
+        throwLogError(env, log, "Cannot reopen preferences log");
+        goto done;
+    }
+
+    from = (uint64_t)st[0];
+    if ((uint64_t)st[1] != HEADER(log)->id || from < sizeof(LogHeader)) {
+        from = sizeof(LogHeader);
+    }
+
+    /* Complete records form a prefix; stop at the first incomplete one */
+    for (offset = from; ; count++) {
+        uint32_t len = slotLength(log, offset);
+        if (len == 0 || (len & RECORD_PENDING)) {
+            break;
+        }
+        offset += len;
+    }
+
+    stringClass = (*env)->FindClass(env, "java/lang/String");
+    if (stringClass == NULL) {
+        goto done;
+    }
+    result = (*env)->NewObjectArray(env, count * 4, stringClass, NULL);
+    if (result == NULL) {
+        goto done;
+    }
+
+    for (i = 0, offset = from; i < count; i++) {
+        uint32_t len = RECORD_AT(log, offset)->length;
+        if (isValidRecord(log, offset, len)) {
+            const LogRecord* rec = RECORD_AT(log, offset);
+            char op[2];
+            jstring s;
+
+            op[0] = (char)rec->op;
+            op[1] = '\0';
+            s = (*env)->NewStringUTF(env, op);
+            if (s == NULL) {
+                result = NULL;
+                goto done;
+            }
+            (*env)->SetObjectArrayElement(env, result, i * 4, s);
+            (*env)->DeleteLocalRef(env, s);
+
+            s = newRecordString(env, recordNode(rec), rec->nodeLen);
+            if (s == NULL) {
+                result = NULL;
+                goto done;
+            }
+            (*env)->SetObjectArrayElement(env, result, i * 4 + 1, s);
+            (*env)->DeleteLocalRef(env, s);
+
+            if (rec->op == OP_PUT || rec->op == OP_REMOVE) {
+                s = newRecordString(env, recordKey(rec), rec->keyLen);
+                if (s == NULL) {
+                    result = NULL;
+                    goto done;
+                }
+                (*env)->SetObjectArrayElement(env, result, i * 4 + 2, s);
+                (*env)->DeleteLocalRef(env, s);
+            }
+            if (rec->op == OP_PUT) {
+                s = newRecordString(env, recordKey(rec) + rec->keyLen,
+                                    rec->valueLen);
+                if (s == NULL) {
+                    result = NULL;
+                    goto done;
+                }
+                (*env)->SetObjectArrayElement(env, result, i * 4 + 3, s);
+                (*env)->DeleteLocalRef(env, s);
+            }
+        }
+        /* A damaged record leaves its four elements null */
+        offset += len;
+    }
+
+    st[0] = (jlong)offset;
+    st[1] = (jlong)HEADER(log)->id;
+    (*env)->SetLongArrayRegion(env, state, 0, 2, st);
+
+done:
+    pthread_mutex_unlock(&log->lock);
+    return result;
+}
+
+/*
+ * Rewrites the log without overwritten and removed entries if it has
+ * grown large, or always if 'force' is set. Returns true if the log
+ * was compacted by this call.
+ *
+ * Class:     java_util_prefs_FileSystemPreferencesLog
+ * Method:    compact0
+ * Signature: (JZ)Z
+ */
+JNIEXPORT jboolean JNICALL
+Java_java_util_prefs_FileSystemPreferencesLog_compact0(JNIEnv* env,
+    jclass thisclass, jlong handle, jboolean force) {
+    PrefsLog* log = (PrefsLog*)jlong_to_ptr(handle);
+    int rc;
+
+    pthread_mutex_lock(&log->lock);
+    rc = compactLog(log, force);
+    if (rc < 0) {
+        throwLogError(env, log, "Cannot compact preferences log");
+    }
+    pthread_mutex_unlock(&log->lock);
+    return rc > 0 ? JNI_TRUE : JNI_FALSE;
+}
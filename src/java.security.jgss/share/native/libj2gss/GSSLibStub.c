@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2005, 2023, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2005, 2026, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -26,6 +26,7 @@
 #include "sun_security_jgss_wrapper_GSSLibStub.h"
 #include "NativeUtil.h"
 #include "NativeFunc.h"
+#include "NativeCredCache.h"
 #include "jlong.h"
 #include <jni.h>
 
@@ -81,6 +82,10 @@ Java_sun_security_jgss_wrapper_GSSLibStub_init(JNIEnv *env,
         tlsCBCl = (*env)->NewGlobalRef(env, cl);
     }
 
+    if (!failed) {
+        initCredCache(env);
+    }
+
     if (!failed) {
         return JNI_TRUE;
     } else {
@@ -627,22 +632,37 @@ Java_sun_security_jgss_wrapper_GSSLibStub_acquireCred(JNIEnv *env,
   gss_cred_usage_t credUsage;
   gss_name_t nameHdl;
   gss_cred_id_t credHdl;
+  OM_uint32 timeRec;
+  char *cacheKey;
+  size_t cacheKeyLen;
   credHdl = GSS_C_NO_CREDENTIAL;
 
   TRACE0("[GSSLibStub_acquireCred]");
 
   mech = (gss_OID) jlong_to_ptr((*env)->GetLongField(env, jobj, FID_GSSLibStub_pMech));
-  mechs = newGSSOIDSet(mech);
   credUsage = (gss_cred_usage_t) usage;
   nameHdl = (gss_name_t) jlong_to_ptr(pName);
 
   TRACE2("[GSSLibStub_acquireCred] pName=%ld, usage=%d", (long)pName, usage);
 
+  cacheKey = newCredCacheKey(nameHdl, reqTime, mech, usage, &cacheKeyLen);
+  if (cacheKey != NULL) {
+    credHdl = lookupCachedCred(env, cacheKey, cacheKeyLen);
+    if (credHdl != GSS_C_NO_CREDENTIAL) {
+      free(cacheKey);
+      TRACE1("[GSSLibStub_acquireCred] cached pCred=%" PRIuPTR "",
+             (uintptr_t) credHdl);
+      return ptr_to_jlong(credHdl);
+    }
+  }
+
+  mechs = newGSSOIDSet(mech);
+
   /* gss_acquire_cred(...) => GSS_S_BAD_MECH, GSS_S_BAD_NAMETYPE,
      GSS_S_BAD_NAME, GSS_S_CREDENTIALS_EXPIRED, GSS_S_NO_CRED */
   major =
     (*ftab->acquireCred)(&minor, nameHdl, reqTime, mechs,
-                     credUsage, &credHdl, NULL, NULL);
+                     credUsage, &credHdl, NULL, &timeRec);
   /* release intermediate buffers */
   deleteGSSOIDSet(mechs);
 
@@ -650,8 +670,12 @@ Java_sun_security_jgss_wrapper_GSSLibStub_acquireCred(JNIEnv *env,
 
   checkStatus(env, jobj, major, minor, "[GSSLibStub_acquireCred]");
   if ((*env)->ExceptionCheck(env)) {
+    free(cacheKey);
     return jlong_zero;
   }
+  if (cacheKey != NULL) {
+    storeCachedCred(env, cacheKey, cacheKeyLen, credHdl, timeRec);
+  }
   return ptr_to_jlong(credHdl);
 }
 
@@ -672,6 +696,9 @@ Java_sun_security_jgss_wrapper_GSSLibStub_releaseCred(JNIEnv *env,
 
   TRACE1("[GSSLibStub_releaseCred] %ld", (long int)pCred);
 
+  if (credHdl != GSS_C_NO_CREDENTIAL && releaseCachedCred(env, credHdl)) {
+    return jlong_zero;
+  }
   if (credHdl != GSS_C_NO_CREDENTIAL) {
     /* gss_release_cred(...) => GSS_S_NO_CRED(!) */
     major = (*ftab->releaseCred)(&minor, &credHdl);
@@ -889,6 +916,7 @@ Java_sun_security_jgss_wrapper_GSSLibStub_initContext(JNIEnv *env,
   gss_buffer_desc inToken;
   gss_buffer_desc outToken;
   jbyteArray jresult;
+  char inTokenStorage[GSS_TOKEN_STORAGE_SIZE];
 /* UNCOMMENT after SEAM bug#6287358 is backported to S10
   gss_OID aMech;
   jobject jMech;
@@ -910,7 +938,8 @@ Java_sun_security_jgss_wrapper_GSSLibStub_initContext(JNIEnv *env,
     return NULL;
   }
 
-  initGSSBuffer(env, jinToken, &inToken);
+  initGSSBufferWithStorage(env, jinToken, &inToken,
+                           inTokenStorage, sizeof(inTokenStorage));
   if ((*env)->ExceptionCheck(env)) {
     deleteGSSCB(cb);
     return NULL;
@@ -968,7 +997,7 @@ Java_sun_security_jgss_wrapper_GSSLibStub_initContext(JNIEnv *env,
 
   /* release intermediate buffers before checking status */
   deleteGSSCB(cb);
-  resetGSSBuffer(&inToken);
+  resetGSSBufferWithStorage(&inToken, inTokenStorage);
   jresult = getJavaBuffer(env, &outToken);
   if ((*env)->ExceptionCheck(env)) {
     return NULL;
@@ -1012,19 +1041,21 @@ Java_sun_security_jgss_wrapper_GSSLibStub_acceptContext(JNIEnv *env,
   jboolean setTarget;
   gss_name_t targetName;
   jobject jtargetName;
+  char inTokenStorage[GSS_TOKEN_STORAGE_SIZE];
 
   TRACE0("[GSSLibStub_acceptContext]");
 
   contextHdl = contextHdlSave = (gss_ctx_id_t)jlong_to_ptr(
     (*env)->GetLongField(env, jcontextSpi, FID_NativeGSSContext_pContext));
   credHdl = (gss_cred_id_t) jlong_to_ptr(pCred);
-  initGSSBuffer(env, jinToken, &inToken);
+  initGSSBufferWithStorage(env, jinToken, &inToken,
+                           inTokenStorage, sizeof(inTokenStorage));
   if ((*env)->ExceptionCheck(env)) {
     return NULL;
   }
   cb = newGSSCB(env, jcb);
   if ((*env)->ExceptionCheck(env)) {
-    resetGSSBuffer(&inToken);
+    resetGSSBufferWithStorage(&inToken, inTokenStorage);
     return NULL;
   }
   srcName = targetName = GSS_C_NO_NAME;
@@ -1047,7 +1078,7 @@ Java_sun_security_jgss_wrapper_GSSLibStub_acceptContext(JNIEnv *env,
   /* release intermediate buffers before checking status */
 
   deleteGSSCB(cb);
-  resetGSSBuffer(&inToken);
+  resetGSSBufferWithStorage(&inToken, inTokenStorage);
 
   TRACE3("[GSSLibStub_acceptContext] after: pCred=%" PRIuPTR ", pContext=%" PRIuPTR ", pDelegCred=%" PRIuPTR "",
         (uintptr_t)credHdl, (uintptr_t)contextHdl, (uintptr_t) delCred);
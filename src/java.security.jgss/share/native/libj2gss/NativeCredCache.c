@@ -0,0 +1,331 @@
+/*
+ * Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "NativeCredCache.h"
+#include "NativeUtil.h"
+#include "NativeFunc.h"
+#include "jni_util.h"
+
+/*
+ * System property holding the number of seconds a credential handle
+ * is reused for; 0 disables the cache.
+ */
+#define CRED_CACHE_TIME_PROP    "sun.security.jgss.native.credCacheTime"
+#define CRED_CACHE_TIME         60
+
+/* Credentials about to expire are never cached */
+#define CRED_MIN_LIFETIME       30
+
+#define CRED_CACHE_MAX_ENTRIES  64
+
+typedef struct CredCacheEntry {
+  char *key;
+  size_t keyLen;
+  gss_cred_id_t cred;
+  time_t expires;
+  int refs;     /* handed out and not yet released */
+  int cached;   /* still returned by lookups */
+  struct CredCacheEntry *next;
+} CredCacheEntry;
+
+static jobject credCacheLock = NULL;
+static jint credCacheTime = CRED_CACHE_TIME;
+
+/* Most recently stored first */
+static CredCacheEntry *credCache = NULL;
+static int cachedCount = 0;
+
+/*
+ * Sets up the cache, reading its configuration from the system
+ * properties. The cache stays disabled if this fails.
+ */
+void initCredCache(JNIEnv *env) {
+  jstring jprop;
+  jstring jvalue;
+  jobject lock;
+  const char *value;
+
+  if (credCacheLock != NULL) {
+    return;
+  }
+
+  jprop = (*env)->NewStringUTF(env, CRED_CACHE_TIME_PROP);
+  if (jprop == NULL) {
+    (*env)->ExceptionClear(env);
+    return;
+  }
+  jvalue = JNU_CallStaticMethodByName(env, NULL, "java/lang/System",
+                                      "getProperty",
+                                      "(Ljava/lang/String;)Ljava/lang/String;",
+                                      jprop).l;
+  (*env)->DeleteLocalRef(env, jprop);
+  if ((*env)->ExceptionCheck(env)) {
+    (*env)->ExceptionClear(env);
+    return;
+  }
+  if (jvalue != NULL) {
+    value = (*env)->GetStringUTFChars(env, jvalue, NULL);
+    if (value == NULL) {
+      (*env)->ExceptionClear(env);
+      return;
+    }
+    credCacheTime = atoi(value);
+    (*env)->ReleaseStringUTFChars(env, jvalue, value);
+    (*env)->DeleteLocalRef(env, jvalue);
+  }
+  TRACE1("[CredCache] cache time=%d", (int) credCacheTime);
+  if (credCacheTime <= 0) {
+    return;
+  }
+
+  lock = (*env)->AllocObject(env, CLS_Object);
+  if (lock == NULL) {
+    (*env)->ExceptionClear(env);
+    return;
+  }
+  credCacheLock = (*env)->NewGlobalRef(env, lock);
+  (*env)->DeleteLocalRef(env, lock);
+}
+
+static char* putBytes(char *p, const void *bytes, size_t len) {
+  memcpy(p, &len, sizeof(len));
+  p += sizeof(len);
+  if (len > 0) {
+    memcpy(p, bytes, len);
+  }
+  return p + len;
+}
+
+static size_t envLength(const char *value) {
+  return value == NULL ? 0 : strlen(value);
+}
+
+/*
+ * Returns a key identifying credentials acquired with the given
+ * arguments, or NULL if they should not be cached.
+ * NOTE: the key must be freed unless passed to storeCachedCred().
+ */
+char* newCredCacheKey(gss_name_t name, jint reqTime, gss_OID mech,
+                      jint usage, size_t *keyLen) {
+  OM_uint32 minor, major;
+  gss_buffer_desc nameBuf;
+  gss_OID nameType = GSS_C_NO_OID;
+  /* Default credentials depend on where they are looked up */
+  const char *ccache = getenv("KRB5CCNAME");
+  const char *keytab = getenv("KRB5_KTNAME");
+  size_t size;
+  char *key;
+  char *p;
+
+  if (credCacheLock == NULL) {
+    return NULL;
+  }
+
+  nameBuf.length = 0;
+  nameBuf.value = NULL;
+  if (name != GSS_C_NO_NAME) {
+    major = (*ftab->displayName)(&minor, name, &nameBuf, &nameType);
+    if (GSS_ERROR(major)) {
+      return NULL;
+    }
+  }
+
+  size = sizeof(usage) + sizeof(reqTime) + 5 * sizeof(size_t)
+    + (mech != GSS_C_NO_OID ? mech->length : 0)
+    + (nameType != GSS_C_NO_OID ? nameType->length : 0)
+    + nameBuf.length + envLength(ccache) + envLength(keytab);
+  key = malloc(size);
+  if (key != NULL) {
+    memcpy(key, &usage, sizeof(usage));
+    memcpy(key + sizeof(usage), &reqTime, sizeof(reqTime));
+    p = key + sizeof(usage) + sizeof(reqTime);
+    p = putBytes(p, mech != GSS_C_NO_OID ? mech->elements : NULL,
+                 mech != GSS_C_NO_OID ? mech->length : 0);
+    p = putBytes(p, nameType != GSS_C_NO_OID ? nameType->elements : NULL,
+                 nameType != GSS_C_NO_OID ? nameType->length : 0);
+    p = putBytes(p, nameBuf.value, nameBuf.length);
+    p = putBytes(p, ccache, envLength(ccache));
+    putBytes(p, keytab, envLength(keytab));
+    *keyLen = size;
+  }
+  if (name != GSS_C_NO_NAME) {
+    (*ftab->releaseBuffer)(&minor, &nameBuf);
+  }
+  return key;
+}
+
+static void freeEntry(CredCacheEntry *entry) {
+  OM_uint32 minor;
+
+  TRACE1("[CredCache] release pCred=%" PRIuPTR "", (uintptr_t) entry->cred);
+  (*ftab->releaseCred)(&minor, &entry->cred);
+  free(entry->key);
+  free(entry);
+}
+
+/*
+ * Drops the entry from the lookups, releasing it if nobody uses it.
+ * Returns the entry following it in the list.
+ */
+static CredCacheEntry* uncacheEntry(CredCacheEntry **prev) {
+  CredCacheEntry *entry = *prev;
+
+  if (entry->cached) {
+    entry->cached = 0;
+    cachedCount--;
+  }
+  if (entry->refs > 0) {
+    return entry->next;
+  }
+  *prev = entry->next;
+  freeEntry(entry);
+  return *prev;
+}
+
+/*
+ * Returns a cached handle for the given key, or GSS_C_NO_CREDENTIAL.
+ * The handle must be released with releaseCachedCred().
+ */
+gss_cred_id_t lookupCachedCred(JNIEnv *env, const char *key, size_t keyLen) {
+  CredCacheEntry **prev;
+  CredCacheEntry *entry;
+  gss_cred_id_t result = GSS_C_NO_CREDENTIAL;
+  time_t now = time(NULL);
+
+  if ((*env)->MonitorEnter(env, credCacheLock) != JNI_OK) {
+    (*env)->ExceptionClear(env);
+    return GSS_C_NO_CREDENTIAL;
+  }
+  prev = &credCache;
+  while ((entry = *prev) != NULL) {
+    if (entry->cached && entry->expires <= now) {
+      uncacheEntry(prev);
+      continue;
+    }
+    if (entry->cached && entry->keyLen == keyLen
+        && memcmp(entry->key, key, keyLen) == 0) {
+      entry->refs++;
+      result = entry->cred;
+      break;
+    }
+    prev = &entry->next;
+  }
+  (*env)->MonitorExit(env, credCacheLock);
+  return result;
+}
+
+/*
+ * Caches a handle that was just acquired and handed out to one caller.
+ * Takes over the key.
+ */
+void storeCachedCred(JNIEnv *env, char *key, size_t keyLen,
+                     gss_cred_id_t cred, OM_uint32 lifetime) {
+  CredCacheEntry *entry;
+  CredCacheEntry **prev;
+  CredCacheEntry **last = NULL;
+  time_t ttl = credCacheTime;
+
+  if (lifetime != GSS_C_INDEFINITE) {
+    if (lifetime <= CRED_MIN_LIFETIME) {
+      free(key);
+      return;
+    }
+    if ((time_t) (lifetime - CRED_MIN_LIFETIME) < ttl) {
+      ttl = (time_t) (lifetime - CRED_MIN_LIFETIME);
+    }
+  }
+
+  entry = calloc(1, sizeof(CredCacheEntry));
+  if (entry == NULL) {
+    free(key);
+    return;
+  }
+  entry->key = key;
+  entry->keyLen = keyLen;
+  entry->cred = cred;
+  entry->expires = time(NULL) + ttl;
+  entry->refs = 1;
+  entry->cached = 1;
+
+  if ((*env)->MonitorEnter(env, credCacheLock) != JNI_OK) {
+    (*env)->ExceptionClear(env);
+    free(key);
+    free(entry);
+    return;
+  }
+  /* Make room by dropping the oldest entry still cached */
+  if (cachedCount >= CRED_CACHE_MAX_ENTRIES) {
+    for (prev = &credCache; *prev != NULL; prev = &(*prev)->next) {
+      if ((*prev)->cached) {
+        last = prev;
+      }
+    }
+    if (last != NULL) {
+      uncacheEntry(last);
+    }
+  }
+  entry->next = credCache;
+  credCache = entry;
+  cachedCount++;
+  (*env)->MonitorExit(env, credCacheLock);
+
+  TRACE2("[CredCache] cached pCred=%" PRIuPTR " for %ld seconds",
+         (uintptr_t) cred, (long) ttl);
+}
+
+/*
+ * Releases one use of a handle obtained through the cache. Returns 0 if
+ * the handle does not belong to the cache; the caller releases it then.
+ */
+int releaseCachedCred(JNIEnv *env, gss_cred_id_t cred) {
+  CredCacheEntry **prev;
+  CredCacheEntry *entry;
+  time_t now = time(NULL);
+  int found = 0;
+
+  if (credCacheLock == NULL) {
+    return 0;
+  }
+  if ((*env)->MonitorEnter(env, credCacheLock) != JNI_OK) {
+    (*env)->ExceptionClear(env);
+    return 0;
+  }
+  for (prev = &credCache; (entry = *prev) != NULL; prev = &entry->next) {
+    if (entry->cred == cred) {
+      found = 1;
+      entry->refs--;
+      if (entry->refs == 0 && (!entry->cached || entry->expires <= now)) {
+        uncacheEntry(prev);
+      }
+      break;
+    }
+  }
+  (*env)->MonitorExit(env, credCacheLock);
+  return found;
+}
@@ -0,0 +1,52 @@
+/*
+ * Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+#include <jni.h>
+#include "gssapi.h"
+
+#ifndef _Included_NATIVE_CredCache
+#define _Included_NATIVE_CredCache
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Cache of credential handles obtained with gss_acquire_cred, keyed by
+ * the desired name, lifetime, mechanism and usage. A cached handle may
+ * be handed out to several callers at once; it is released once it has
+ * expired from the cache and every caller has released it.
+ */
+
+  extern void initCredCache(JNIEnv *);
+  extern char* newCredCacheKey(gss_name_t, jint, gss_OID, jint, size_t *);
+  extern gss_cred_id_t lookupCachedCred(JNIEnv *, const char *, size_t);
+  extern void storeCachedCred(JNIEnv *, char *, size_t, gss_cred_id_t,
+                              OM_uint32);
+  extern int releaseCachedCred(JNIEnv *, gss_cred_id_t);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2005, 2023, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2005, 2026, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -627,6 +627,45 @@ void resetGSSBuffer(gss_buffer_t cbytes) {
   }
 }
 
+/*
+ * Same as initGSSBuffer(), except that the bytes are copied into the
+ * specified storage if they fit, so that no memory is allocated for
+ * the tokens of a typical context establishment.
+ * NOTE: must call resetGSSBufferWithStorage() with the same storage.
+ */
+void initGSSBufferWithStorage(JNIEnv *env, jbyteArray jbytes,
+                              gss_buffer_t cbytes,
+                              void *storage, size_t storageSize) {
+  jsize len;
+
+  if (jbytes != NULL) {
+    len = (*env)->GetArrayLength(env, jbytes);
+    if ((size_t) len <= storageSize) {
+      (*env)->GetByteArrayRegion(env, jbytes, 0, len, storage);
+      if (!(*env)->ExceptionCheck(env)) {
+        cbytes->length = len;
+        cbytes->value = storage;
+      }
+      return;
+    }
+  }
+  initGSSBuffer(env, jbytes, cbytes);
+}
+
+/*
+ * Utility routine for freeing the bytes malloc'ed in
+ * initGSSBufferWithStorage() method.
+ */
+void resetGSSBufferWithStorage(gss_buffer_t cbytes, void *storage) {
+  if ((cbytes != NULL) && (cbytes != GSS_C_NO_BUFFER)) {
+    if (cbytes->value != storage) {
+      free(cbytes->value);
+    }
+    cbytes->length = 0;
+    cbytes->value = NULL;
+  }
+}
+
 /*
  * Utility routine for creating a jbyteArray object using
  * the byte[] value in specified gss_buffer_t structure.
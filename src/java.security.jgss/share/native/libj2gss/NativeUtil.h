@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2005, 2023, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2005, 2026, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -41,6 +41,9 @@ extern "C" {
   extern void gssThrowOutOfMemoryError(JNIEnv *, const char*);
   extern void initGSSBuffer(JNIEnv *, jbyteArray, gss_buffer_t);
   extern void resetGSSBuffer(gss_buffer_t);
+  extern void initGSSBufferWithStorage(JNIEnv *, jbyteArray, gss_buffer_t,
+                                       void *, size_t);
+  extern void resetGSSBufferWithStorage(gss_buffer_t, void *);
 
   extern gss_OID newGSSOID(JNIEnv *, jobject);
   extern void deleteGSSOID(gss_OID);
@@ -57,6 +60,9 @@ extern "C" {
 
   extern int JGSS_DEBUG;
 
+  /* Context tokens up to this size are not copied to the heap */
+  #define GSS_TOKEN_STORAGE_SIZE 8192
+
   extern jclass CLS_Object;
   extern jclass CLS_GSSNameElement;
   extern jclass CLS_GSSCredElement;
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2005, 2018, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2005, 2026, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -25,15 +25,19 @@
 
 #include "jni_util.h"
 
+#include <sys/inotify.h>
 #include <sys/socket.h>
 #include <sys/stat.h>
 #include <sys/types.h>
 #include <sys/un.h>
 #include <errno.h>
+#include <limits.h>
+#include <poll.h>
 #include <signal.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <time.h>
 #include <unistd.h>
 
 #include "sun_tools_attach_VirtualMachineImpl.h"
@@ -46,6 +50,12 @@
 
 #define ROOT_UID 0
 
+/* Size of buffer used to copy data between sockets and Java byte arrays */
+#define IO_BUFFER_SIZE 8192
+
+/* Maximum number of descriptors waited for at once */
+#define MAX_WAIT_FDS 1024
+
 /*
  * Declare library specific JNI_Onload entry if static build
  */
@@ -125,6 +135,156 @@ JNIEXPORT void JNICALL Java_sun_tools_attach_VirtualMachineImpl_sendQuitTo
     }
 }
 
+/*
+ * Class:     sun_tools_attach_VirtualMachineImpl
+ * Method:    waitForSocketFile
+ * Signature: (Ljava/lang/String;Ljava/lang/String;J)Z
+ *
+ * Waits up to timeout milliseconds for a file with the given name to
+ * appear in the given directory, typically for the attach listener socket
+ * after SIGQUIT was sent. Uses inotify, so the caller wakes up as soon as
+ * the socket is created instead of polling for it. Returns true if the
+ * file exists, false on timeout. Throws IOException if the directory
+ * cannot be watched; the caller may then fall back to polling.
+ */
+JNIEXPORT jboolean JNICALL Java_sun_tools_attach_VirtualMachineImpl_waitForSocketFile
+  (JNIEnv *env, jclass cls, jstring dir, jstring name, jlong timeout)
+{
+    jboolean isDirCopy, isNameCopy;
+    const char* d;
+    const char* n;
+    char path[PATH_MAX];
+    char events[sizeof(struct inotify_event) + NAME_MAX + 1]
+        __attribute__ ((aligned(__alignof__(struct inotify_event))));
+    struct stat64 sb;
+    struct timespec now;
+    jlong deadline;
+    jboolean found = JNI_FALSE;
+    int err = 0;
+    int fd = -1;
+
+    d = GetStringPlatformChars(env, dir, &isDirCopy);
+    if (d == NULL) {
+        return JNI_FALSE;
+    }
+    n = GetStringPlatformChars(env, name, &isNameCopy);
+    if (n == NULL) {
+        if (isDirCopy) {
+            JNU_ReleaseStringPlatformChars(env, dir, d);
+        }
+        return JNI_FALSE;
+    }
+
+    if (snprintf(path, sizeof(path), "%s/%s", d, n) >= (int)sizeof(path)) {
+        err = ENAMETOOLONG;
+        goto done;
+    }
+
+    fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (fd == -1 || inotify_add_watch(fd, d, IN_CREATE | IN_MOVED_TO) == -1) {
+        err = errno;
+        goto done;
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    deadline = (jlong)now.tv_sec * 1000 + now.tv_nsec / 1000000 + timeout;
+
+    /* Check after the watch is in place so that no creation is missed */
+    while (stat64(path, &sb) != 0) {
+        struct pollfd pfd;
+        jlong remaining;
+        ssize_t len;
+        int res;
+
+        clock_gettime(CLOCK_MONOTONIC, &now);
+        remaining = deadline - ((jlong)now.tv_sec * 1000 + now.tv_nsec / 1000000);
+        if (remaining <= 0) {
+            goto done;
+        }
+
+        pfd.fd = fd;
+        pfd.events = POLLIN;
+        pfd.revents = 0;
+        res = poll(&pfd, 1, remaining > INT_MAX ? INT_MAX : (int)remaining);
+        if (res == -1 && errno != EINTR) {
+            err = errno;
+            goto done;
+        }
+
+        /* Drain events, the name is checked with stat64 above anyway */
+        do {
+            len = read(fd, events, sizeof(events));
+        } while (len > 0 || (len == -1 && errno == EINTR));
+    }
+    found = JNI_TRUE;
+
+done:
+    if (fd != -1) {
+        int res;
+        RESTARTABLE(close(fd), res);
+    }
+    if (isNameCopy) {
+        JNU_ReleaseStringPlatformChars(env, name, n);
+    }
+    if (isDirCopy) {
+        JNU_ReleaseStringPlatformChars(env, dir, d);
+    }
+    if (err != 0) {
+        char* msg = strdup(strerror(err));
+        JNU_ThrowIOException(env, msg);
+        if (msg != NULL) {
+            free(msg);
+        }
+    }
+    return found;
+}
+
+/*
+ * Class:     sun_tools_attach_VirtualMachineImpl
+ * Method:    waitForInput
+ * Signature: ([I[ZJ)I
+ *
+ * Waits up to timeout milliseconds (forever if negative) until any of
+ * the given sockets has data to read or was closed by the peer, so a
+ * single thread can drive attach connections to many VMs at once.
+ * Sets ready[i] for every such socket and returns their number.
+ */
+JNIEXPORT jint JNICALL Java_sun_tools_attach_VirtualMachineImpl_waitForInput
+  (JNIEnv *env, jclass cls, jintArray fds, jbooleanArray ready, jlong timeout)
+{
+    struct pollfd pfds[MAX_WAIT_FDS];
+    jint fdBuf[MAX_WAIT_FDS];
+    jboolean readyBuf[MAX_WAIT_FDS];
+    jsize count = (*env)->GetArrayLength(env, fds);
+    int res;
+    jsize i;
+
+    if (count > MAX_WAIT_FDS || count > (*env)->GetArrayLength(env, ready)) {
+        JNU_ThrowIllegalArgumentException(env, "too many sockets");
+        return 0;
+    }
+
+    (*env)->GetIntArrayRegion(env, fds, 0, count, fdBuf);
+    for (i = 0; i < count; i++) {
+        pfds[i].fd = fdBuf[i];
+        pfds[i].events = POLLIN;
+        pfds[i].revents = 0;
+    }
+
+    RESTARTABLE(poll(pfds, (nfds_t)count,
+        timeout < 0 ? -1 : (timeout > INT_MAX ? INT_MAX : (int)timeout)), res);
+    if (res == -1) {
+        JNU_ThrowIOExceptionWithLastError(env, "poll");
+        return 0;
+    }
+
+    for (i = 0; i < count; i++) {
+        readyBuf[i] = (pfds[i].revents != 0) ? JNI_TRUE : JNI_FALSE;
+    }
+    (*env)->SetBooleanArrayRegion(env, ready, 0, count, readyBuf);
+    return (jint)res;
+}
+
 /*
  * Class:     sun_tools_attach_VirtualMachineImpl
  * Method:    checkPermissions
@@ -211,7 +371,7 @@ JNIEXPORT void JNICALL Java_sun_tools_attach_VirtualMachineImpl_close
 JNIEXPORT jint JNICALL Java_sun_tools_attach_VirtualMachineImpl_read
   (JNIEnv *env, jclass cls, jint fd, jbyteArray ba, jint off, jint baLen)
 {
-    unsigned char buf[128];
+    unsigned char buf[IO_BUFFER_SIZE];
     size_t len = sizeof(buf);
     ssize_t n;
 
@@ -243,7 +403,7 @@ JNIEXPORT void JNICALL Java_sun_tools_attach_VirtualMachineImpl_write
 {
     size_t remaining = bufLen;
     do {
-        unsigned char buf[128];
+        unsigned char buf[IO_BUFFER_SIZE];
         size_t len = sizeof(buf);
         int n;
 
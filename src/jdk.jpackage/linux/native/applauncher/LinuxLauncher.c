@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2021, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2021, 2026, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -32,9 +32,11 @@
 #include <sys/wait.h>
 #include <unistd.h>
 #include <stddef.h>
+#include <limits.h>
 #include <libgen.h>
 #include "JvmLauncher.h"
 #include "LinuxPackage.h"
+#include "LinuxLauncherCache.h"
 
 
 #define STATUS_FAILURE 1
@@ -45,8 +47,193 @@ static int appArgc;
 static char **appArgv;
 
 
+#define JVML_LAUNCHER_DATA_CACHE_SUFFIX "jld"
+
+/* Environment variables libapplauncher takes into account */
+static const char* const cacheKeyEnvVars[] = {
+    "HOME",
+    "LD_LIBRARY_PATH",
+    "_JPACKAGE_LAUNCHER"
+};
+
+
+static int appendCacheKey(char** key, size_t* keySize, const char* str,
+                                                            size_t strSize) {
+    char* newKey = realloc(*key, *keySize + strSize);
+    if (!newKey) {
+        JP_LOG_ERRNO;
+        return 0;
+    }
+    memcpy(newKey + *keySize, str, strSize);
+    *key = newKey;
+    *keySize += strSize;
+    return 1;
+}
+
+
+/*
+ * JvmlLauncherData depends on the launcher path, the command line and
+ * a few environment variables. Key of the cached data is a sequence of
+ * '\0' terminated strings: launcher path, number of command line arguments,
+ * the arguments, and NAME=VALUE (or just NAME if not set) for environment
+ * variables from cacheKeyEnvVars.
+ */
+static char* getCacheKey(size_t* keySize) {
+    char* modulePath = 0;
+    char* key = 0;
+    char argcStr[16];
+    const char* value;
+    size_t i;
+    int ok;
+
+    *keySize = 0;
+
+    modulePath = getModulePath();
+    if (!modulePath) {
+        return 0;
+    }
+
+    snprintf(argcStr, sizeof(argcStr), "%d", appArgc);
+    ok = appendCacheKey(&key, keySize, modulePath, strlen(modulePath) + 1)
+            && appendCacheKey(&key, keySize, argcStr, strlen(argcStr) + 1);
+    for (i = 0; ok && i != (size_t)appArgc; i++) {
+        ok = appendCacheKey(&key, keySize, appArgv[i], strlen(appArgv[i]) + 1);
+    }
+    for (i = 0; ok && i != sizeof(cacheKeyEnvVars) / sizeof(cacheKeyEnvVars[0]);
+                                                                        i++) {
+        value = getenv(cacheKeyEnvVars[i]);
+        ok = appendCacheKey(&key, keySize, cacheKeyEnvVars[i],
+                                            strlen(cacheKeyEnvVars[i]))
+                && (!value || (appendCacheKey(&key, keySize, "=", 1)
+                && appendCacheKey(&key, keySize, value, strlen(value))))
+                && appendCacheKey(&key, keySize, "", 1);
+    }
+
+    if (!ok) {
+        free(key);
+        key = 0;
+    }
+
+    free(modulePath);
+    return key;
+}
+
+
+/*
+ * Returns malloc'ed "<dir>/<name>" string.
+ */
+static char* makePath(const char* dir, const char* name) {
+    char* result = malloc(strlen(dir) + 1 + strlen(name) + 1);
+    if (!result) {
+        JP_LOG_ERRNO;
+    } else {
+        strcpy(result, dir);
+        strcat(result, "/");
+        strcat(result, name);
+    }
+    return result;
+}
+
+
+/*
+ * Saves packed JvmlLauncherData computed by libapplauncher. This is
+ * the compiled form of the config file: expanded options, resolved runtime
+ * and the exact JLI_Launch() arguments. The entry depends on everything
+ * libapplauncher reads: the launcher executable, package databases,
+ * libapplauncher itself, all the places config file is looked up in and
+ * JLI library of the runtime.
+ */
+static void storeCachedJvmlLauncherData(const JvmlLauncherData* data,
+                int size, const char* jliLibPath, const char* launcherLibPath,
+                const char* pkgName) {
+    const char* const* dbFiles = 0;
+    const char* deps[16];
+    char* paths[6] = { 0 };
+    char* cfgFileName = 0;
+    char* libDir = 0;
+    char* key = 0;
+    size_t keySize = 0;
+    const char* home = getenv("HOME");
+    int dbFileCount;
+    int depCount = 0;
+    size_t i;
+
+    key = getCacheKey(&keySize);
+    if (!key) {
+        goto cleanup;
+    }
+
+    /* Launcher path is the first string of the key */
+    paths[0] = strdup(key);
+    libDir = strdup(launcherLibPath);
+    if (!paths[0] || !libDir) {
+        JP_LOG_ERRNO;
+        goto cleanup;
+    }
+
+    cfgFileName = malloc(strlen(key) + sizeof(".cfg"));
+    if (!cfgFileName) {
+        JP_LOG_ERRNO;
+        goto cleanup;
+    }
+    strcpy(cfgFileName, basename(paths[0]));
+    strcat(cfgFileName, ".cfg");
+
+    deps[depCount++] = key;
+    deps[depCount++] = launcherLibPath;
+    deps[depCount++] = jliLibPath;
+
+    dbFileCount = getPackageDbFiles(&dbFiles);
+    for (i = 0; i != (size_t)dbFileCount; i++) {
+        deps[depCount++] = dbFiles[i];
+    }
+
+    /* Config file is in "app" subdirectory of launcher lib directory */
+    paths[1] = makePath(dirname(libDir), "app");
+    paths[2] = paths[1] ? makePath(paths[1], cfgFileName) : 0;
+    if (!paths[2]) {
+        goto cleanup;
+    }
+    deps[depCount++] = paths[2];
+
+    /* Per-user config files of package installs */
+    if (pkgName && home) {
+        paths[3] = makePath(home, ".local");
+        paths[4] = paths[3] ? makePath(paths[3], pkgName) : 0;
+        free(paths[3]);
+        paths[3] = paths[4] ? makePath(paths[4], cfgFileName) : 0;
+        free(paths[4]);
+        paths[4] = malloc(strlen(home) + 2 + strlen(pkgName) + 1
+                                                    + strlen(cfgFileName) + 1);
+        if (!paths[3] || !paths[4]) {
+            JP_LOG_ERRNO;
+            goto cleanup;
+        }
+        sprintf(paths[4], "%s/.%s/%s", home, pkgName, cfgFileName);
+        deps[depCount++] = paths[3];
+        deps[depCount++] = paths[4];
+    }
+
+    storeLauncherCache(JVML_LAUNCHER_DATA_CACHE_SUFFIX, key, keySize,
+                        deps, depCount, data, (size_t)size);
+
+cleanup:
+    for (i = 0; i != sizeof(paths) / sizeof(paths[0]); i++) {
+        free(paths[i]);
+    }
+    free(cfgFileName);
+    free(libDir);
+    free(key);
+}
+
+
+/*
+ * Returns packed JvmlLauncherData.
+ */
 static JvmlLauncherData* initJvmlLauncherData(int* size) {
     char* launcherLibPath = 0;
+    char* pkgName = 0;
+    char* jliLibPath = 0;
     void* jvmLauncherLibHandle = 0;
     JvmlLauncherAPI_GetAPIFunc getApi = 0;
     JvmlLauncherAPI_CreateFunType createJvmlLauncher = 0;
@@ -54,7 +241,7 @@ static JvmlLauncherData* initJvmlLauncherData(int* size) {
     JvmlLauncherHandle jvmLauncherHandle = 0;
     JvmlLauncherData* result = 0;
 
-    launcherLibPath = getJvmLauncherLibPath();
+    launcherLibPath = getJvmLauncherLibPath(&pkgName);
     if (!launcherLibPath) {
         goto cleanup;
     }
@@ -92,6 +279,18 @@ static JvmlLauncherData* initJvmlLauncherData(int* size) {
     /* Handle released in jvmLauncherCreateJvmlLauncherData() */
     jvmLauncherHandle = 0;
 
+    if (result) {
+        jliLibPath = strdup(result->jliLibPath);
+        if (!jliLibPath) {
+            JP_LOG_ERRNO;
+        }
+        jvmLauncherPackJvmlLauncherData(result);
+        if (jliLibPath) {
+            storeCachedJvmlLauncherData(result, *size, jliLibPath,
+                                                    launcherLibPath, pkgName);
+        }
+    }
+
 cleanup:
     if (jvmLauncherHandle) {
         jvmLauncherCloseHandle(api, jvmLauncherHandle);
@@ -100,6 +299,8 @@ cleanup:
         dlclose(jvmLauncherLibHandle);
     }
     free(launcherLibPath);
+    free(pkgName);
+    free(jliLibPath);
 
     return result;
 }
@@ -141,27 +342,40 @@ static void closePipeEnd(int* pipefd, int idx) {
 }
 
 
-static void initJvmlLauncherDataPointers(void* baseAddress,
-                                        JvmlLauncherData* jvmLauncherData) {
-    ptrdiff_t offset = (char*)jvmLauncherData - (char*)baseAddress;
-    int i;
+/*
+ * Returns JvmlLauncherData saved by a previous launch with the same command
+ * line and environment or NULL. The data is unpacked in place in private
+ * mapping of the cache file described by 'view'.
+ */
+static JvmlLauncherData* mapCachedJvmlLauncherData(LauncherCacheView* view) {
+    char* key = 0;
+    size_t keySize = 0;
+    void* payload = 0;
+    size_t payloadSize = 0;
+    JvmlLauncherData* result = 0;
 
-    jvmLauncherData->jliLibPath += offset;
-    jvmLauncherData->jliLaunchArgv =
-            (char**)((char*)jvmLauncherData->jliLaunchArgv + offset);
-    jvmLauncherData->envVarNames =
-            (char**)((char*)jvmLauncherData->envVarNames + offset);
-    jvmLauncherData->envVarValues =
-            (char**)((char*)jvmLauncherData->envVarValues + offset);
+    key = getCacheKey(&keySize);
+    if (!key) {
+        view->addr = 0;
+        view->size = 0;
+        return 0;
+    }
 
-    for (i = 0; i != jvmLauncherData->jliLaunchArgc; i++) {
-        jvmLauncherData->jliLaunchArgv[i] += offset;
+    payload = mapLauncherCache(JVML_LAUNCHER_DATA_CACHE_SUFFIX, key, keySize,
+                                                        &payloadSize, view);
+    if (payload && payloadSize <= (size_t)INT_MAX) {
+        result = jvmLauncherUnpackJvmlLauncherData(payload, (int)payloadSize);
+        if (!result) {
+            JP_LOG_TRACE("cache: invalid launcher data");
+        }
     }
 
-    for (i = 0; i != jvmLauncherData->envVarCount; i++) {
-        jvmLauncherData->envVarNames[i] += offset;
-        jvmLauncherData->envVarValues[i] += offset;
+    if (!result) {
+        unmapLauncherCache(view);
     }
+
+    free(key);
+    return result;
 }
 
 
@@ -171,10 +385,22 @@ int main(int argc, char *argv[]) {
     int exitCode = STATUS_FAILURE;
     JvmlLauncherData* jvmLauncherData = 0;
     int jvmLauncherDataBufferSize = 0;
+    LauncherCacheView cacheView;
 
     appArgc = argc;
     appArgv = argv;
 
+    /*
+     * Computing launcher data may run package manager queries, so skip it
+     * if the same launch was already seen.
+     */
+    jvmLauncherData = mapCachedJvmlLauncherData(&cacheView);
+    if (jvmLauncherData) {
+        exitCode = launchJvm(jvmLauncherData);
+        unmapLauncherCache(&cacheView);
+        return exitCode;
+    }
+
     if (pipe(pipefd) == -1) {
         JP_LOG_ERRNO;
         return exitCode;
@@ -196,13 +422,7 @@ int main(int argc, char *argv[]) {
                 goto cleanup;
             }
             if (jvmLauncherDataBufferSize) {
-                /* Buffer address */
-                if (write(pipefd[1], &jvmLauncherData,
-                                            sizeof(jvmLauncherData)) == -1) {
-                    JP_LOG_ERRNO;
-                    goto cleanup;
-                }
-                /* Buffer data */
+                /* Packed buffer data */
                 if (write(pipefd[1], jvmLauncherData,
                                             jvmLauncherDataBufferSize) == -1) {
                     JP_LOG_ERRNO;
@@ -213,8 +433,6 @@ int main(int argc, char *argv[]) {
 
         exitCode = 0;
     } else if (cpid > 0) {
-        void* baseAddress = 0;
-
         /* Close unused write end */
         closePipeEnd(pipefd, 1);
 
@@ -229,11 +447,6 @@ int main(int argc, char *argv[]) {
             goto cleanup;
         }
 
-        if (read(pipefd[0], &baseAddress, sizeof(baseAddress)) == -1) {
-            JP_LOG_ERRNO;
-            goto cleanup;
-        }
-
         jvmLauncherData = malloc(jvmLauncherDataBufferSize);
         if (!jvmLauncherData) {
             JP_LOG_ERRNO;
@@ -249,7 +462,11 @@ int main(int argc, char *argv[]) {
         closePipeEnd(pipefd, 0);
         wait(NULL); /* Wait child process to terminate */
 
-        initJvmlLauncherDataPointers(baseAddress, jvmLauncherData);
+        if (!jvmLauncherUnpackJvmlLauncherData(jvmLauncherData,
+                                                jvmLauncherDataBufferSize)) {
+            JP_LOG_ERRMSG("Invalid launcher data");
+            goto cleanup;
+        }
         exitCode = launchJvm(jvmLauncherData);
     }
 
@@ -0,0 +1,454 @@
+/*
+ * Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <linux/limits.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "JvmLauncher.h"
+#include "LinuxLauncherCache.h"
+
+
+/*
+ * Cache file layout, all values in host byte order:
+ *
+ *     char[8]     CACHE_MAGIC
+ *     uint32_t    key size
+ *     char[]      key
+ *     uint32_t    number of dependencies
+ *       uint32_t  path size, including trailing '\0'
+ *       char[]    path
+ *       FileStamp state of the file when the entry was stored
+ *     uint64_t    payload size
+ *     char[]      zero padding up to CACHE_PAYLOAD_ALIGNMENT boundary
+ *     char[]      payload
+ *
+ * Files are mapped copy-on-write, so callers can modify payload in place.
+ */
+
+#define CACHE_MAGIC "JPLCACH2"
+#define CACHE_MAGIC_SIZE 8
+#define CACHE_DIR_NAME "jpackage-launcher"
+#define CACHE_MAX_FILE_SIZE (16 * 1024 * 1024)
+#define CACHE_PAYLOAD_ALIGNMENT 16
+
+typedef struct {
+    uint64_t dev;
+    uint64_t ino;
+    uint64_t size;
+    int64_t mtimeSec;
+    int64_t mtimeNsec;
+    int64_t exists;
+} FileStamp;
+
+
+static void getFileStamp(const char* path, FileStamp* stamp) {
+    struct stat st;
+
+    memset(stamp, 0, sizeof(*stamp));
+    if (stat(path, &st) == 0) {
+        stamp->dev = (uint64_t)st.st_dev;
+        stamp->ino = (uint64_t)st.st_ino;
+        stamp->size = (uint64_t)st.st_size;
+        stamp->mtimeSec = (int64_t)st.st_mtim.tv_sec;
+        stamp->mtimeNsec = (int64_t)st.st_mtim.tv_nsec;
+        stamp->exists = 1;
+    }
+}
+
+
+static int isCacheEnabled(void) {
+    const char* value = getenv("JPACKAGE_LAUNCHER_CACHE");
+    return !value || strcmp(value, "false");
+}
+
+
+/*
+ * Returns malloc'ed path of the cache directory or NULL. Creates the
+ * directory if 'create' is non-zero.
+ */
+static char* getCacheDir(int create) {
+    const char* base = getenv("XDG_CACHE_HOME");
+    const char* home = getenv("HOME");
+    char parent[PATH_MAX];
+    char* result = 0;
+    size_t len;
+
+    if (base && *base == '/') {
+        len = (size_t)snprintf(parent, sizeof(parent), "%s", base);
+    } else if (home && *home == '/') {
+        len = (size_t)snprintf(parent, sizeof(parent), "%s/.cache", home);
+    } else {
+        return 0;
+    }
+    if (len >= sizeof(parent)) {
+        return 0;
+    }
+
+    result = malloc(len + sizeof("/" CACHE_DIR_NAME));
+    if (!result) {
+        JP_LOG_ERRNO;
+        return 0;
+    }
+    strcpy(result, parent);
+    strcat(result, "/" CACHE_DIR_NAME);
+
+    if (create) {
+        if (mkdir(parent, 0700) != 0 && errno != EEXIST) {
+            JP_LOG_TRACE("cache: mkdir(%s): %s", parent, strerror(errno));
+        }
+        if (mkdir(result, 0700) != 0 && errno != EEXIST) {
+            JP_LOG_TRACE("cache: mkdir(%s): %s", result, strerror(errno));
+            free(result);
+            result = 0;
+        }
+    }
+
+    return result;
+}
+
+
+static char* getCacheFilePath(const char* suffix, const char* key,
+                                                    size_t keySize, int create) {
+    /* FNV-1a */
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    char* dir = 0;
+    char* result = 0;
+    size_t i;
+
+    for (i = 0; i != keySize; i++) {
+        hash ^= (unsigned char)key[i];
+        hash *= 0x100000001b3ULL;
+    }
+
+    dir = getCacheDir(create);
+    if (!dir) {
+        return 0;
+    }
+
+    result = malloc(strlen(dir) + 1 + 16 + 1 + strlen(suffix) + 1);
+    if (!result) {
+        JP_LOG_ERRNO;
+    } else {
+        sprintf(result, "%s/%016llx.%s", dir, (unsigned long long)hash,
+                                                                    suffix);
+    }
+
+    free(dir);
+    return result;
+}
+
+
+static char* mapCacheFile(const char* path, size_t* size) {
+    struct stat st;
+    void* addr = 0;
+    int fd;
+
+    fd = open(path, O_RDONLY | O_CLOEXEC | O_NOFOLLOW);
+    if (fd < 0) {
+        return 0;
+    }
+
+    /* Only trust a regular file of the current user */
+    if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode)
+            || st.st_uid != geteuid() || (st.st_mode & (S_IWGRP | S_IWOTH))
+            || st.st_size <= 0 || st.st_size > CACHE_MAX_FILE_SIZE) {
+        goto cleanup;
+    }
+
+    addr = mmap(0, (size_t)st.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE,
+                                                                    fd, 0);
+    if (addr == MAP_FAILED) {
+        JP_LOG_TRACE("cache: mmap(%s): %s", path, strerror(errno));
+        addr = 0;
+    } else {
+        *size = (size_t)st.st_size;
+    }
+
+cleanup:
+    close(fd);
+    return addr;
+}
+
+
+typedef struct {
+    const char* cur;
+    const char* end;
+} Reader;
+
+
+static const void* take(Reader* r, size_t n) {
+    const char* result = r->cur;
+    if ((size_t)(r->end - r->cur) < n) {
+        return 0;
+    }
+    r->cur += n;
+    return result;
+}
+
+
+static int takeU32(Reader* r, uint32_t* v) {
+    const void* p = take(r, sizeof(*v));
+    if (!p) {
+        return 0;
+    }
+    memcpy(v, p, sizeof(*v));
+    return 1;
+}
+
+
+void* mapLauncherCache(const char* suffix, const char* key, size_t keySize,
+                    size_t* payloadSize, LauncherCacheView* view) {
+    char* path = 0;
+    char* buf = 0;
+    size_t bufSize = 0;
+    void* result = 0;
+    Reader r;
+    const void* p;
+    uint32_t count;
+    uint32_t len;
+    uint64_t size;
+    FileStamp recorded;
+    FileStamp current;
+    const char* depPath;
+
+    view->addr = 0;
+    view->size = 0;
+
+    if (!isCacheEnabled()) {
+        return 0;
+    }
+
+    path = getCacheFilePath(suffix, key, keySize, 0);
+    if (!path) {
+        return 0;
+    }
+
+    buf = mapCacheFile(path, &bufSize);
+    if (!buf) {
+        goto cleanup;
+    }
+
+    r.cur = buf;
+    r.end = buf + bufSize;
+
+    p = take(&r, CACHE_MAGIC_SIZE);
+    if (!p || memcmp(p, CACHE_MAGIC, CACHE_MAGIC_SIZE)) {
+        goto cleanup;
+    }
+
+    /* Hash collision or a different key */
+    if (!takeU32(&r, &len) || len != keySize) {
+        goto cleanup;
+    }
+    p = take(&r, len);
+    if (!p || memcmp(p, key, len)) {
+        goto cleanup;
+    }
+
+    if (!takeU32(&r, &count)) {
+        goto cleanup;
+    }
+    for (; count; count--) {
+        if (!takeU32(&r, &len) || !len) {
+            goto cleanup;
+        }
+        depPath = take(&r, len);
+        p = take(&r, sizeof(recorded));
+        if (!depPath || !p || depPath[len - 1]) {
+            goto cleanup;
+        }
+        memcpy(&recorded, p, sizeof(recorded));
+        getFileStamp(depPath, &current);
+        if (memcmp(&recorded, &current, sizeof(current))) {
+            JP_LOG_TRACE("cache: [%s] changed", depPath);
+            goto cleanup;
+        }
+    }
+
+    p = take(&r, sizeof(size));
+    if (!p) {
+        goto cleanup;
+    }
+    memcpy(&size, p, sizeof(size));
+    if (!take(&r, (size_t)(-(r.cur - buf) & (CACHE_PAYLOAD_ALIGNMENT - 1)))) {
+        goto cleanup;
+    }
+    result = (void*)take(&r, (size_t)size);
+    if (!result || r.cur != r.end) {
+        result = 0;
+        goto cleanup;
+    }
+
+    *payloadSize = (size_t)size;
+    view->addr = buf;
+    view->size = bufSize;
+    buf = 0;
+
+    JP_LOG_TRACE("cache: hit [%s]", path);
+
+cleanup:
+    if (buf) {
+        munmap(buf, bufSize);
+    }
+    free(path);
+    return result;
+}
+
+
+void unmapLauncherCache(LauncherCacheView* view) {
+    if (view->addr) {
+        munmap(view->addr, view->size);
+        view->addr = 0;
+        view->size = 0;
+    }
+}
+
+
+typedef struct {
+    char* begin;
+    size_t size;
+    size_t capacity;
+    int failed;
+} Writer;
+
+
+static void put(Writer* w, const void* data, size_t n) {
+    char* newBuf;
+    size_t newCapacity;
+
+    if (w->failed) {
+        return;
+    }
+
+    if (w->capacity - w->size < n) {
+        newCapacity = (w->capacity + n) * 2;
+        newBuf = realloc(w->begin, newCapacity);
+        if (!newBuf) {
+            JP_LOG_ERRNO;
+            w->failed = 1;
+            return;
+        }
+        w->begin = newBuf;
+        w->capacity = newCapacity;
+    }
+
+    memcpy(w->begin + w->size, data, n);
+    w->size += n;
+}
+
+
+static void putU32(Writer* w, uint32_t v) {
+    put(w, &v, sizeof(v));
+}
+
+
+static int writeCacheFile(const char* path, const char* data, size_t size) {
+    char tmpPath[PATH_MAX];
+    size_t done = 0;
+    ssize_t n;
+    int fd;
+
+    if ((size_t)snprintf(tmpPath, sizeof(tmpPath), "%s.%ld", path,
+                                        (long)getpid()) >= sizeof(tmpPath)) {
+        return 0;
+    }
+
+    fd = open(tmpPath, O_WRONLY | O_CREAT | O_EXCL | O_CLOEXEC | O_NOFOLLOW,
+                                                                        0600);
+    if (fd < 0) {
+        JP_LOG_TRACE("cache: open(%s): %s", tmpPath, strerror(errno));
+        return 0;
+    }
+
+    while (done < size) {
+        n = write(fd, data + done, size - done);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            break;
+        }
+        done += (size_t)n;
+    }
+
+    /* Readers never see a partially written file */
+    if (close(fd) != 0 || done != size || rename(tmpPath, path) != 0) {
+        JP_LOG_TRACE("cache: failed to write [%s]", path);
+        unlink(tmpPath);
+        return 0;
+    }
+
+    return 1;
+}
+
+
+void storeLauncherCache(const char* suffix, const char* key, size_t keySize,
+                        const char* const* deps, int depCount,
+                        const void* payload, size_t payloadSize) {
+    static const char padding[CACHE_PAYLOAD_ALIGNMENT] = { 0 };
+    Writer w = { 0, 0, 0, 0 };
+    FileStamp stamp;
+    uint64_t size = payloadSize;
+    char* path = 0;
+    int i;
+
+    if (!isCacheEnabled()) {
+        return;
+    }
+
+    put(&w, CACHE_MAGIC, CACHE_MAGIC_SIZE);
+    putU32(&w, (uint32_t)keySize);
+    put(&w, key, keySize);
+    putU32(&w, (uint32_t)depCount);
+    for (i = 0; i != depCount; i++) {
+        getFileStamp(deps[i], &stamp);
+        putU32(&w, (uint32_t)(strlen(deps[i]) + 1));
+        put(&w, deps[i], strlen(deps[i]) + 1);
+        put(&w, &stamp, sizeof(stamp));
+    }
+    put(&w, &size, sizeof(size));
+    put(&w, padding, -w.size & (CACHE_PAYLOAD_ALIGNMENT - 1));
+    put(&w, payload, payloadSize);
+
+    if (w.failed || w.size > CACHE_MAX_FILE_SIZE) {
+        goto cleanup;
+    }
+
+    path = getCacheFilePath(suffix, key, keySize, 1);
+    if (path && writeCacheFile(path, w.begin, w.size)) {
+        JP_LOG_TRACE("cache: stored [%s]", path);
+    }
+
+cleanup:
+    free(path);
+    free(w.begin);
+}
@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+#ifndef LinuxLauncherCache_h
+#define LinuxLauncherCache_h
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Per-user cache of data the launcher would otherwise compute on every
+ * start. Entries live in $XDG_CACHE_HOME/jpackage-launcher (or
+ * $HOME/.cache/jpackage-launcher), one file per key. Every entry records
+ * the files it was computed from; it is ignored once any of them changes,
+ * appears or disappears.
+ *
+ * Setting JPACKAGE_LAUNCHER_CACHE environment variable to "false" disables
+ * the cache.
+ */
+
+typedef struct {
+    void* addr;
+    size_t size;
+} LauncherCacheView;
+
+/*
+ * Maps the entry stored under the given key and suffix into memory and
+ * returns its payload, or NULL if there is no such entry or it is out of
+ * date. The payload is aligned to 16 bytes and can be modified; changes
+ * are private to the process. The key may contain '\0' characters.
+ * The mapping is released with unmapLauncherCache().
+ */
+void* mapLauncherCache(const char* suffix, const char* key, size_t keySize,
+                        size_t* payloadSize, LauncherCacheView* view);
+
+void unmapLauncherCache(LauncherCacheView* view);
+
+/*
+ * Stores the payload under the given key and suffix together with stamps
+ * of 'deps' files. Failures are logged and otherwise ignored.
+ */
+void storeLauncherCache(const char* suffix, const char* key, size_t keySize,
+                        const char* const* deps, int depCount,
+                        const void* payload, size_t payloadSize);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* #ifndef LinuxLauncherCache_h */
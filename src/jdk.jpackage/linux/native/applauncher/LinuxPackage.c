@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2021, 2022, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2021, 2026, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -33,9 +33,10 @@
 #include <libgen.h>
 #include "JvmLauncher.h"
 #include "LinuxPackage.h"
+#include "LinuxLauncherCache.h"
 
 
-static char* getModulePath(void) {
+char* getModulePath(void) {
     char modulePath[PATH_MAX] = { 0 };
     ssize_t modulePathLen = 0;
     char* result = 0;
@@ -292,25 +293,155 @@ static PackageDesc* findOwnerOfFile(const char* path) {
 }
 
 
-char* getJvmLauncherLibPath(void) {
+/*
+ * Package databases. Installing, upgrading or removing any package changes
+ * at least one of these files.
+ */
+static const char* const packageDbFiles[] = {
+    "/var/lib/rpm/rpmdb.sqlite",
+    "/var/lib/rpm/Packages",
+    "/usr/lib/sysimage/rpm/rpmdb.sqlite",
+    "/usr/lib/sysimage/rpm/Packages",
+    "/var/lib/dpkg/status"
+};
+
+#define PACKAGE_DB_FILE_COUNT \
+        ((int)(sizeof(packageDbFiles) / sizeof(packageDbFiles[0])))
+
+#define PACKAGE_CACHE_SUFFIX "pkg"
+
+
+int getPackageDbFiles(const char* const** files) {
+    *files = packageDbFiles;
+    return PACKAGE_DB_FILE_COUNT;
+}
+
+
+/*
+ * Cached result of getJvmLauncherLibPath() is a sequence of '\0' terminated
+ * strings: package type, package name and launcher lib path.
+ */
+static char* loadCachedLauncherLibPath(const char* modulePath,
+                                                        char** packageName) {
+    LauncherCacheView view;
+    char* payload = 0;
+    size_t payloadSize = 0;
+    const char* type;
+    const char* name;
+    const char* libPath;
+    char* result = 0;
+
+    payload = mapLauncherCache(PACKAGE_CACHE_SUFFIX, modulePath,
+                                strlen(modulePath), &payloadSize, &view);
+    if (!payload || !payloadSize || payload[payloadSize - 1]) {
+        goto cleanup;
+    }
+
+    type = payload;
+    name = type + strlen(type) + 1;
+    if (name >= payload + payloadSize) {
+        goto cleanup;
+    }
+    libPath = name + strlen(name) + 1;
+    if (libPath >= payload + payloadSize || !*libPath) {
+        goto cleanup;
+    }
+
+    result = strdup(libPath);
+    if (!result) {
+        JP_LOG_ERRNO;
+        goto cleanup;
+    }
+
+    if (packageName && *name) {
+        *packageName = strdup(name);
+        if (!*packageName) {
+            JP_LOG_ERRNO;
+            free(result);
+            result = 0;
+        }
+    }
+
+    JP_LOG_TRACE("cached launcher lib: (%s|%s)", result, name);
+
+cleanup:
+    unmapLauncherCache(&view);
+    return result;
+}
+
+
+static void storeCachedLauncherLibPath(const char* modulePath,
+                        const PackageDesc* pkg, const char* launcherLibPath) {
+    const char* deps[1 + PACKAGE_DB_FILE_COUNT];
+    char type[16];
+    const char* name = pkg ? pkg->name : "";
+    char* payload = 0;
+    size_t typeLen;
+    size_t nameLen;
+    size_t libPathLen;
+    int i;
+
+    deps[0] = modulePath;
+    for (i = 0; i != PACKAGE_DB_FILE_COUNT; i++) {
+        deps[i + 1] = packageDbFiles[i];
+    }
+
+    typeLen = (size_t)snprintf(type, sizeof(type), "%d",
+                                pkg ? pkg->type : PACKAGE_TYPE_UNKNOWN) + 1;
+    nameLen = strlen(name) + 1;
+    libPathLen = strlen(launcherLibPath) + 1;
+
+    payload = malloc(typeLen + nameLen + libPathLen);
+    if (!payload) {
+        JP_LOG_ERRNO;
+        return;
+    }
+    memcpy(payload, type, typeLen);
+    memcpy(payload + typeLen, name, nameLen);
+    memcpy(payload + typeLen + nameLen, launcherLibPath, libPathLen);
+
+    storeLauncherCache(PACKAGE_CACHE_SUFFIX, modulePath, strlen(modulePath),
+                            deps, 1 + PACKAGE_DB_FILE_COUNT,
+                            payload, typeLen + nameLen + libPathLen);
+    free(payload);
+}
+
+
+char* getJvmLauncherLibPath(char** packageName) {
     char* modulePath = 0;
+    char* modulePathCopy = 0;
     char* appImageDir = 0;
     char* launcherLibPath = 0;
     const char* pkgQueryCmd = 0;
     int popenStatus = -1;
     PackageDesc* pkg = 0;
 
+    if (packageName) {
+        *packageName = 0;
+    }
+
     modulePath = getModulePath();
     if (!modulePath) {
         goto cleanup;
     }
 
+    /* Querying package manager takes much longer than the rest of launch */
+    launcherLibPath = loadCachedLauncherLibPath(modulePath, packageName);
+    if (launcherLibPath) {
+        goto cleanup;
+    }
+
     pkg = findOwnerOfFile(modulePath);
     if (!pkg) {
         /* Not a package install */
         /* Launcher should be in "bin" subdirectory of app image. */
         /* Launcher lib should be in "lib" subdirectory of app image. */
-        appImageDir = dirname(dirname(modulePath));
+        modulePathCopy = strdup(modulePath);
+        if (!modulePathCopy) {
+            JP_LOG_ERRNO;
+            goto cleanup;
+        }
+        appImageDir = dirname(dirname(modulePathCopy));
         launcherLibPath = concat(appImageDir, "/lib" LAUNCHER_LIB_NAME);
     } else {
         if (PACKAGE_TYPE_RPM == pkg->type) {
@@ -330,10 +461,22 @@ char* getJvmLauncherLibPath(void) {
             launcherLibPath = NULL;
             goto cleanup;
         }
+
+        if (launcherLibPath && packageName) {
+            *packageName = strdup(pkg->name);
+            if (!*packageName) {
+                JP_LOG_ERRNO;
+            }
+        }
+    }
+
+    if (launcherLibPath) {
+        storeCachedLauncherLibPath(modulePath, pkg, launcherLibPath);
     }
 
 cleanup:
     free(modulePath);
+    free(modulePathCopy);
     freePackageDesc(pkg);
 
     return launcherLibPath;
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2021, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2021, 2026, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -30,7 +30,23 @@
 extern "C" {
 #endif
 
-char* getJvmLauncherLibPath(void);
+/*
+ * Returns malloc'ed path to libapplauncher.so or NULL. If the launcher is
+ * installed from a package and 'packageName' is not NULL, stores malloc'ed
+ * name of the package in it.
+ */
+char* getJvmLauncherLibPath(char** packageName);
+
+/*
+ * Returns malloc'ed path to the launcher executable or NULL.
+ */
+char* getModulePath(void);
+
+/*
+ * Returns number of package database files and the files themselves in
+ * 'files'. Their changes invalidate cached package information.
+ */
+int getPackageDbFiles(const char* const** files);
 
 #ifdef __cplusplus
 }
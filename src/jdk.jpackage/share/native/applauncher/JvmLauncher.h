@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2020, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2020, 2026, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -86,6 +86,21 @@ JvmlLauncherData* jvmLauncherCreateJvmlLauncherData(JvmlLauncherAPI* api,
                                             JvmlLauncherHandle h, int* size);
 int jvmLauncherStartJvm(JvmlLauncherData* jvmArgs, void* JLI_Launch);
 
+/*
+ * Replaces pointers in JvmlLauncherData buffer with offsets from the start
+ * of the buffer. Packed buffer can be copied or saved and unpacked later
+ * at any address.
+ */
+void jvmLauncherPackJvmlLauncherData(JvmlLauncherData* jvmArgs);
+
+/*
+ * Unpacks JvmlLauncherData buffer packed with
+ * jvmLauncherPackJvmlLauncherData() in place. Returns NULL if the buffer
+ * is malformed.
+ */
+JvmlLauncherData* jvmLauncherUnpackJvmlLauncherData(void* ptr,
+                                                        int bufferSize);
+
 void jvmLauncherLog(const char* format, ...);
 
 #define JP_LOG_ERRMSG(msg) do { jvmLauncherLog((msg)); } while (0)
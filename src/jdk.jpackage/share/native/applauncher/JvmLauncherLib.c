@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2021, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2021, 2026, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -85,6 +85,127 @@ cleanup:
 }
 
 
+/*
+ * Pointers of JvmlLauncherData and of its string arrays all point inside of
+ * the buffer holding JvmlLauncherData. Packed buffer has them replaced with
+ * offsets from the start of the buffer, so it can be copied or mapped at
+ * any address. Arrays are not necessarily aligned, hence memcpy().
+ */
+
+static void packPointer(char* slot, const char* base) {
+    char* ptr;
+    memcpy(&ptr, slot, sizeof(ptr));
+    ptr = (char*)(ptr - base);
+    memcpy(slot, &ptr, sizeof(ptr));
+}
+
+
+static void packStringArray(char* base, void* arr, int count) {
+    int i;
+    for (i = 0; i != count; i++) {
+        packPointer((char*)arr + i * sizeof(char*), base);
+    }
+}
+
+
+void jvmLauncherPackJvmlLauncherData(JvmlLauncherData* jvmArgs) {
+    char* base = (char*)jvmArgs;
+
+    packStringArray(base, jvmArgs->jliLaunchArgv, jvmArgs->jliLaunchArgc);
+    packStringArray(base, jvmArgs->envVarNames, jvmArgs->envVarCount);
+    packStringArray(base, jvmArgs->envVarValues, jvmArgs->envVarCount);
+
+    jvmArgs->jliLibPath = (char*)(jvmArgs->jliLibPath - base);
+    jvmArgs->jliLaunchArgv = (char**)((char*)jvmArgs->jliLaunchArgv - base);
+    jvmArgs->envVarNames = (TCHAR**)((char*)jvmArgs->envVarNames - base);
+    jvmArgs->envVarValues = (TCHAR**)((char*)jvmArgs->envVarValues - base);
+}
+
+
+/*
+ * Returns non-zero if 'offset' is an offset of a zero terminated string
+ * of 'charSize' bytes long characters in 'size' bytes long buffer.
+ */
+static int isValidString(const char* base, size_t size, size_t offset,
+                                                            size_t charSize) {
+    static const char zero[sizeof(TCHAR)] = { 0 };
+    for (; offset <= size && size - offset >= charSize; offset += charSize) {
+        if (!memcmp(base + offset, zero, charSize)) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+
+static int unpackStringArray(char* base, size_t size, size_t offset,
+                                                int count, size_t charSize) {
+    size_t strOffset;
+    int i;
+
+    if (offset < sizeof(JvmlLauncherData) || offset > size
+                    || (size - offset) / sizeof(char*) < (size_t)count) {
+        return 0;
+    }
+
+    for (i = 0; i != count; i++) {
+        memcpy(&strOffset, base + offset + i * sizeof(char*),
+                                                        sizeof(strOffset));
+        if (strOffset < sizeof(JvmlLauncherData)
+                        || !isValidString(base, size, strOffset, charSize)) {
+            return 0;
+        }
+    }
+
+    for (i = 0; i != count; i++) {
+        char* slot = base + offset + i * sizeof(char*);
+        char* ptr;
+        memcpy(&ptr, slot, sizeof(ptr));
+        ptr = base + (size_t)ptr;
+        memcpy(slot, &ptr, sizeof(ptr));
+    }
+
+    return 1;
+}
+
+
+JvmlLauncherData* jvmLauncherUnpackJvmlLauncherData(void* ptr,
+                                                            int bufferSize) {
+    JvmlLauncherData* jvmArgs = (JvmlLauncherData*)ptr;
+    char* base = (char*)ptr;
+    const size_t size = (size_t)bufferSize;
+    size_t jliLibPath;
+
+    if (bufferSize < (int)sizeof(JvmlLauncherData)
+            || jvmArgs->jliLaunchArgc < 0 || jvmArgs->envVarCount < 0) {
+        return 0;
+    }
+
+    jliLibPath = (size_t)jvmArgs->jliLibPath;
+    if (jliLibPath < sizeof(JvmlLauncherData)
+                    || !isValidString(base, size, jliLibPath, sizeof(char))) {
+        return 0;
+    }
+
+    /* Arrays are unpacked one by one, bail out on the first failure */
+    if (!unpackStringArray(base, size, (size_t)jvmArgs->jliLaunchArgv,
+                                    jvmArgs->jliLaunchArgc, sizeof(char))
+            || !unpackStringArray(base, size, (size_t)jvmArgs->envVarNames,
+                                    jvmArgs->envVarCount, sizeof(TCHAR))
+            || !unpackStringArray(base, size, (size_t)jvmArgs->envVarValues,
+                                    jvmArgs->envVarCount, sizeof(TCHAR))) {
+        return 0;
+    }
+
+    jvmArgs->jliLibPath = base + jliLibPath;
+    jvmArgs->jliLaunchArgv = (char**)(base + (size_t)jvmArgs->jliLaunchArgv);
+    jvmArgs->envVarNames = (TCHAR**)(base + (size_t)jvmArgs->envVarNames);
+    jvmArgs->envVarValues = (TCHAR**)(base + (size_t)jvmArgs->envVarValues);
+
+    return jvmArgs;
+}
+
+
 static void dumpJvmlLauncherData(const JvmlLauncherData* jvmArgs) {
     int i = 0;
     JP_LOG_TRACE("jli lib: [%s]", jvmArgs->jliLibPath);
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2000, 2021, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2000, 2026, Oracle and/or its affiliates. All rights reserved.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  * This code is free software; you can redistribute it and/or modify it
@@ -31,9 +31,64 @@
 #include <unistd.h>
 #include <stdlib.h>
 #include <string.h>
+#include <time.h>
+#include <pthread.h>
 
 #include <pwd.h>
 
+/*
+ * The passwd entry of the user, which every UnixSystem instance looks up.
+ * It is kept for a while, so that logins do not each go to the name
+ * service.
+ */
+#define PWD_ENTRY_TTL   30
+
+static pthread_mutex_t pwdLock = PTHREAD_MUTEX_INITIALIZER;
+static int pwdCached = 0;
+static uid_t pwdUid;
+static gid_t pwdGid;
+static char pwdName[1024];
+static time_t pwdExpires;
+
+/*
+ * Looks up the passwd entry of the given user, copying its name to the
+ * buffer. Returns 0 if there is no such user.
+ */
+static int getPasswdEntry(uid_t uid, gid_t *gid, char *name, size_t nameSize) {
+    char pwd_buf[1024];
+    struct passwd *pwd = NULL;
+    struct passwd resbuf;
+    struct timespec ts;
+    int found = 0;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    pthread_mutex_lock(&pwdLock);
+    if (pwdCached && pwdUid == uid && ts.tv_sec < pwdExpires) {
+        *gid = pwdGid;
+        snprintf(name, nameSize, "%s", pwdName);
+        pthread_mutex_unlock(&pwdLock);
+        return 1;
+    }
+    pthread_mutex_unlock(&pwdLock);
+
+    memset(pwd_buf, 0, sizeof(pwd_buf));
+    if (getpwuid_r(uid, &resbuf, pwd_buf, sizeof(pwd_buf), &pwd) == 0 &&
+            pwd != NULL && strlen(pwd->pw_name) < sizeof(pwdName)) {
+        *gid = pwd->pw_gid;
+        snprintf(name, nameSize, "%s", pwd->pw_name);
+        found = 1;
+
+        pthread_mutex_lock(&pwdLock);
+        pwdUid = uid;
+        pwdGid = pwd->pw_gid;
+        strcpy(pwdName, pwd->pw_name);
+        pwdExpires = ts.tv_sec + PWD_ENTRY_TTL;
+        pwdCached = 1;
+        pthread_mutex_unlock(&pwdLock);
+    }
+    return found;
+}
+
 /*
  * Declare library specific JNI_Onload entry if static build
  */
@@ -44,9 +99,9 @@ Java_com_sun_security_auth_module_UnixSystem_getUnixInfo
                                                 (JNIEnv *env, jobject obj) {
 
     int i;
-    char pwd_buf[1024];
-    struct passwd *pwd = NULL;
-    struct passwd resbuf;
+    uid_t uid;
+    gid_t gid;
+    char name[1024];
     jfieldID userNameID;
     jfieldID userID;
     jfieldID groupID;
@@ -110,12 +165,11 @@ Java_com_sun_security_auth_module_UnixSystem_getUnixInfo
         goto cleanUpAndReturn;
     }
 
-    memset(pwd_buf, 0, sizeof(pwd_buf));
-    if (getpwuid_r(getuid(), &resbuf, pwd_buf, sizeof(pwd_buf), &pwd) == 0 &&
-            pwd != NULL) {
-        (*env)->SetLongField(env, obj, userID, pwd->pw_uid);
-        (*env)->SetLongField(env, obj, groupID, pwd->pw_gid);
-        jstr = (*env)->NewStringUTF(env, pwd->pw_name);
+    uid = getuid();
+    if (getPasswdEntry(uid, &gid, name, sizeof(name))) {
+        (*env)->SetLongField(env, obj, userID, uid);
+        (*env)->SetLongField(env, obj, groupID, gid);
+        jstr = (*env)->NewStringUTF(env, name);
         if (jstr == NULL) {
             goto cleanUpAndReturn;
         }
@@ -0,0 +1,183 @@
+/*
+ * Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+/*
+ * @test
+ * @summary Verifies that indexed pixels delivered through the ImageProducer
+ *          API, with one or several color models, render exactly as the
+ *          color map lookup predicts.
+ * @run main/othervm -Djava.awt.headless=true ICMPixelsEquivalence
+ */
+
+import java.awt.Graphics2D;
+import java.awt.Image;
+import java.awt.Toolkit;
+import java.awt.image.BufferedImage;
+import java.awt.image.ColorModel;
+import java.awt.image.ImageConsumer;
+import java.awt.image.ImageObserver;
+import java.awt.image.ImageProducer;
+import java.awt.image.IndexColorModel;
+import java.util.Random;
+
+public class ICMPixelsEquivalence {
+
+    private static final int W = 131;
+    private static final int H = 67;
+
+    public static void main(String[] args) throws Exception {
+        Random rnd = new Random(0x1C3);
+        for (int iter = 0; iter < 20; iter++) {
+            // A single palette exercises the direct LUT expansion, several
+            // palettes force the palette merge of the indexed raster.
+            test(rnd, 1, false);
+            test(rnd, 1 + rnd.nextInt(6), false);
+            test(rnd, 1 + rnd.nextInt(6), true);
+        }
+    }
+
+    private static IndexColorModel randomICM(Random rnd, int size,
+                                             int colors, boolean alpha) {
+        byte[] r = new byte[size];
+        byte[] g = new byte[size];
+        byte[] b = new byte[size];
+        byte[] a = new byte[size];
+        for (int i = 0; i < size; i++) {
+            // a small color space produces duplicates across palettes
+            int c = rnd.nextInt(colors);
+            r[i] = (byte) (c * 37);
+            g[i] = (byte) (c * 91);
+            b[i] = (byte) (c * 13);
+            a[i] = (byte) (alpha && rnd.nextInt(8) == 0 ? 0 : 0xff);
+        }
+        return new IndexColorModel(8, size, r, g, b, a);
+    }
+
+    private static void test(Random rnd, int bands, boolean alpha)
+            throws Exception {
+        IndexColorModel[] icms = new IndexColorModel[bands];
+        int colors = 4 + rnd.nextInt(300);
+        for (int i = 0; i < bands; i++) {
+            icms[i] = randomICM(rnd, 1 + rnd.nextInt(256), colors, alpha);
+        }
+        byte[] pix = new byte[W * H];
+        int[] expected = new int[W * H];
+        for (int y = 0; y < H; y++) {
+            IndexColorModel icm = icms[y * bands / H];
+            for (int x = 0; x < W; x++) {
+                int idx = rnd.nextInt(icm.getMapSize());
+                pix[y * W + x] = (byte) idx;
+                expected[y * W + x] = icm.getRGB(idx);
+            }
+        }
+
+        Image img = Toolkit.getDefaultToolkit().createImage(
+                new BandedProducer(icms, pix));
+        BufferedImage dst = new BufferedImage(W, H,
+                                              BufferedImage.TYPE_INT_ARGB);
+        Graphics2D g = dst.createGraphics();
+        Waiter waiter = new Waiter();
+        synchronized (waiter) {
+            if (!g.drawImage(img, 0, 0, waiter)) {
+                while (!waiter.done) {
+                    waiter.wait();
+                }
+                g.drawImage(img, 0, 0, null);
+            }
+        }
+        g.dispose();
+
+        for (int y = 0; y < H; y++) {
+            for (int x = 0; x < W; x++) {
+                int exp = expected[y * W + x];
+                int act = dst.getRGB(x, y);
+                if ((exp >>> 24) == 0 && (act >>> 24) == 0) {
+                    continue;
+                }
+                if (exp != act) {
+                    throw new RuntimeException(String.format(
+                            "bands=%d: pixel (%d, %d) is %08x, expected %08x",
+                            bands, x, y, act, exp));
+                }
+            }
+        }
+    }
+
+    private static class Waiter implements ImageObserver {
+        boolean done;
+
+        @Override
+        public synchronized boolean imageUpdate(Image img, int flags,
+                                                int x, int y, int w, int h) {
+            if ((flags & (ALLBITS | ERROR | ABORT)) != 0) {
+                done = true;
+                notifyAll();
+                return false;
+            }
+            return true;
+        }
+    }
+
+    /*
+     * Delivers the rows of each band with that band's color model, the
+     * way GIF frames with local color tables are delivered.
+     */
+    private static class BandedProducer implements ImageProducer {
+        private final IndexColorModel[] icms;
+        private final byte[] pix;
+
+        BandedProducer(IndexColorModel[] icms, byte[] pix) {
+            this.icms = icms;
+            this.pix = pix;
+        }
+
+        @Override public void addConsumer(ImageConsumer ic) { }
+        @Override public boolean isConsumer(ImageConsumer ic) { return false; }
+        @Override public void removeConsumer(ImageConsumer ic) { }
+        @Override public void requestTopDownLeftRightResend(ImageConsumer ic) { }
+
+        @Override
+        public void startProduction(ImageConsumer ic) {
+            ColorModel first = icms[0];
+            ic.setDimensions(W, H);
+            ic.setColorModel(first);
+            ic.setHints(ImageConsumer.TOPDOWNLEFTRIGHT
+                        | ImageConsumer.COMPLETESCANLINES
+                        | ImageConsumer.SINGLEPASS
+                        | ImageConsumer.SINGLEFRAME);
+            int bands = icms.length;
+            int y = 0;
+            for (int band = 0; band < bands; band++) {
+                int y1 = y;
+                while (y1 < H && y1 * bands / H == band) {
+                    y1++;
+                }
+                if (y1 > y) {
+                    ic.setPixels(0, y, W, y1 - y, icms[band], pix, y * W, W);
+                }
+                y = y1;
+            }
+            ic.imageComplete(ImageConsumer.STATICIMAGEDONE);
+        }
+    }
+}
@@ -0,0 +1,130 @@
+/*
+ * Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+/*
+ * @test
+ * @summary Verifies that the dedicated IntArgb/IntRgb to ByteIndexed
+ *          conversion loop dithers exactly like the generic ThreeByteBgr
+ *          to ByteIndexed loop, for all dither phases and palettes.
+ * @run main/othervm -Djava.awt.headless=true ByteIndexedDitherEquivalence
+ */
+
+import java.awt.AlphaComposite;
+import java.awt.Graphics2D;
+import java.awt.image.BufferedImage;
+import java.awt.image.IndexColorModel;
+import java.util.Random;
+
+public class ByteIndexedDitherEquivalence {
+
+    public static void main(String[] args) {
+        Random rnd = new Random(0xD17E);
+
+        // The default ByteIndexed palette is a color cube which represents
+        // the primaries, so both the dithered and the exempt paths are hit.
+        BufferedImage cube = new BufferedImage(1, 1,
+                                               BufferedImage.TYPE_BYTE_INDEXED);
+        IndexColorModel cubeICM = (IndexColorModel) cube.getColorModel();
+
+        for (int iter = 0; iter < 40; iter++) {
+            IndexColorModel icm = (iter % 2 == 0) ? cubeICM
+                                                  : randomICM(rnd);
+            int w = 1 + rnd.nextInt(97);
+            int h = 1 + rnd.nextInt(23);
+            int dx = rnd.nextInt(8);
+            int dy = rnd.nextInt(8);
+            int[] rgb = randomPixels(rnd, w * h);
+
+            for (int type : new int[] { BufferedImage.TYPE_INT_RGB,
+                                        BufferedImage.TYPE_INT_ARGB }) {
+                BufferedImage src = new BufferedImage(w, h, type);
+                BufferedImage ref = new BufferedImage(w, h,
+                        BufferedImage.TYPE_3BYTE_BGR);
+                src.setRGB(0, 0, w, h, rgb, 0, w);
+                ref.setRGB(0, 0, w, h, rgb, 0, w);
+
+                BufferedImage actual = render(src, icm, dx, dy);
+                BufferedImage expected = render(ref, icm, dx, dy);
+                compare(actual, expected, iter, type);
+            }
+        }
+    }
+
+    private static int[] randomPixels(Random rnd, int n) {
+        int[] rgb = new int[n];
+        for (int i = 0; i < n; i++) {
+            int c = 0xff000000;
+            for (int shift = 0; shift < 24; shift += 8) {
+                int v;
+                switch (rnd.nextInt(4)) {
+                    case 0:  v = 0;    break;
+                    case 1:  v = 0xff; break;
+                    default: v = rnd.nextInt(256);
+                }
+                c |= v << shift;
+            }
+            rgb[i] = c;
+        }
+        return rgb;
+    }
+
+    private static IndexColorModel randomICM(Random rnd) {
+        int size = 2 + rnd.nextInt(255);
+        byte[] r = new byte[size];
+        byte[] g = new byte[size];
+        byte[] b = new byte[size];
+        rnd.nextBytes(r);
+        rnd.nextBytes(g);
+        rnd.nextBytes(b);
+        return new IndexColorModel(8, size, r, g, b);
+    }
+
+    private static BufferedImage render(BufferedImage src,
+                                        IndexColorModel icm, int dx, int dy) {
+        BufferedImage dst = new BufferedImage(src.getWidth() + 8,
+                                              src.getHeight() + 8,
+                                              BufferedImage.TYPE_BYTE_INDEXED,
+                                              icm);
+        Graphics2D g = dst.createGraphics();
+        // Src selects the plain conversion blit for every source type
+        g.setComposite(AlphaComposite.Src);
+        g.drawImage(src, dx, dy, null);
+        g.dispose();
+        return dst;
+    }
+
+    private static void compare(BufferedImage actual, BufferedImage expected,
+                                int iter, int type) {
+        for (int y = 0; y < actual.getHeight(); y++) {
+            for (int x = 0; x < actual.getWidth(); x++) {
+                int a = actual.getRaster().getSample(x, y, 0);
+                int e = expected.getRaster().getSample(x, y, 0);
+                if (a != e) {
+                    throw new RuntimeException(String.format(
+                            "iteration %d, type %d: index at (%d, %d) is %d, "
+                            + "expected %d", iter, type, x, y, a, e));
+                }
+            }
+        }
+    }
+}
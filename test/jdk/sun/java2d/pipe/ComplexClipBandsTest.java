@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+/*
+ * @test
+ * @summary Verifies that blits and antialiased fills under complex clips
+ *          touch exactly the clipped pixels, both on the first use of a
+ *          clip and when its bands are reused from the native cache.
+ * @run main/othervm -Djava.awt.headless=true ComplexClipBandsTest
+ */
+
+import java.awt.Color;
+import java.awt.Graphics2D;
+import java.awt.Rectangle;
+import java.awt.RenderingHints;
+import java.awt.Shape;
+import java.awt.geom.Area;
+import java.awt.image.BufferedImage;
+import java.util.Random;
+
+public class ComplexClipBandsTest {
+
+    private static final int W = 157;
+    private static final int H = 131;
+
+    public static void main(String[] args) {
+        Random rnd = new Random(0xC11B);
+        BufferedImage src = new BufferedImage(W, H,
+                                              BufferedImage.TYPE_INT_RGB);
+        Graphics2D sg = src.createGraphics();
+        sg.setColor(Color.RED);
+        sg.fillRect(0, 0, W, H);
+        sg.dispose();
+
+        for (int iter = 0; iter < 30; iter++) {
+            // Many disjoint integer rectangles produce a region with many
+            // Y bands and many X spans per band.
+            Area area = new Area();
+            int n = 20 + rnd.nextInt(300);
+            for (int i = 0; i < n; i++) {
+                area.add(new Area(new Rectangle(rnd.nextInt(W), rnd.nextInt(H),
+                                                1 + rnd.nextInt(12),
+                                                1 + rnd.nextInt(12))));
+            }
+            // Draw repeatedly with the same Graphics so the same Region
+            // object is used again.
+            BufferedImage dst = new BufferedImage(W, H,
+                                                  BufferedImage.TYPE_INT_RGB);
+            Graphics2D g = dst.createGraphics();
+            g.setClip(area);
+            for (int pass = 0; pass < 3; pass++) {
+                int tx = rnd.nextInt(40) - 20;
+                int ty = rnd.nextInt(40) - 20;
+                clear(dst);
+                g.drawImage(src, tx, ty, null);
+                check(dst, area, new Rectangle(tx, ty, W, H), "blit", iter);
+
+                clear(dst);
+                g.setRenderingHint(RenderingHints.KEY_ANTIALIASING,
+                                   RenderingHints.VALUE_ANTIALIAS_ON);
+                g.setColor(Color.RED);
+                Rectangle r = new Rectangle(tx, ty, W / 2 + rnd.nextInt(W),
+                                            H / 2 + rnd.nextInt(H));
+                g.fill(r);
+                g.setRenderingHint(RenderingHints.KEY_ANTIALIASING,
+                                   RenderingHints.VALUE_ANTIALIAS_OFF);
+                check(dst, area, r, "aa fill", iter);
+            }
+            g.dispose();
+        }
+    }
+
+    private static void clear(BufferedImage img) {
+        for (int y = 0; y < H; y++) {
+            for (int x = 0; x < W; x++) {
+                img.setRGB(x, y, 0);
+            }
+        }
+    }
+
+    private static void check(BufferedImage img, Shape clip, Rectangle r,
+                              String what, int iter)
+    {
+        for (int y = 0; y < H; y++) {
+            for (int x = 0; x < W; x++) {
+                boolean in = clip.contains(x + 0.5, y + 0.5) &&
+                             r.contains(x, y);
+                int expected = in ? 0xffff0000 : 0xff000000;
+                int actual = img.getRGB(x, y);
+                if (actual != expected) {
+                    throw new RuntimeException(what + " (iteration " + iter +
+                        ") pixel " + x + "," + y + ": expected " +
+                        Integer.toHexString(expected) + " but got " +
+                        Integer.toHexString(actual));
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,65 @@
+/*
+ * Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+/*
+ * @test
+ * @summary Verifies that JDK_JAVA_STARTUP_TRACE writes a Chrome trace of
+ *          the launcher and native library startup phases.
+ * @library /test/lib
+ * @run main StartupTraceTest
+ */
+
+import java.nio.file.Files;
+import java.nio.file.Path;
+
+import jdk.test.lib.JDKToolFinder;
+import jdk.test.lib.process.OutputAnalyzer;
+import jdk.test.lib.process.ProcessTools;
+
+public class StartupTraceTest {
+
+    public static void main(String[] args) throws Exception {
+        Path trace = Path.of("startup-trace.json").toAbsolutePath();
+        Files.deleteIfExists(trace);
+
+        ProcessBuilder pb = new ProcessBuilder(
+            JDKToolFinder.getJDKTool("java"), "-version");
+        pb.environment().put("JDK_JAVA_STARTUP_TRACE", trace.toString());
+        OutputAnalyzer out = ProcessTools.executeProcess(pb);
+        out.shouldHaveExitValue(0);
+
+        String json = Files.readString(trace);
+        System.out.println(json);
+        if (!json.startsWith("{\"traceEvents\":[") ||
+            !json.contains("\"dropped\":0")) {
+            throw new RuntimeException("unexpected trace layout");
+        }
+        for (String phase : new String[] { "LoadJavaVM", "ParseArguments",
+                                           "InitializeJVM", "JIMAGE_Open" }) {
+            if (!json.contains("{\"name\":\"" + phase + "\",\"ph\":\"B\"") ||
+                !json.contains("{\"name\":\"" + phase + "\",\"ph\":\"E\"")) {
+                throw new RuntimeException("phase " + phase + " not recorded");
+            }
+        }
+    }
+}
@@ -0,0 +1,150 @@
+/*
+ * Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+/*
+ * @test
+ * @summary Verifies the launcher side of the JDK_JAVA_ZYGOTE protocol: the
+ *          request sent to the zygote, the exit status it reports, and the
+ *          fallback to a normal launch when the zygote is missing or
+ *          declines.
+ * @requires os.family != "windows"
+ * @library /test/lib
+ * @run main ZygoteLaunchTest
+ */
+
+import java.io.IOException;
+import java.net.StandardProtocolFamily;
+import java.net.UnixDomainSocketAddress;
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
+import java.nio.channels.ServerSocketChannel;
+import java.nio.channels.SocketChannel;
+import java.nio.charset.StandardCharsets;
+import java.nio.file.Files;
+import java.nio.file.Path;
+import java.util.ArrayList;
+import java.util.List;
+
+import jdk.test.lib.JDKToolFinder;
+import jdk.test.lib.process.OutputAnalyzer;
+import jdk.test.lib.process.ProcessTools;
+
+public class ZygoteLaunchTest {
+
+    private static final int MAGIC = 0x4A5A5931;
+
+    public static void main(String[] args) throws Exception {
+        // Socket paths are short, so stay out of the scratch directory
+        Path dir = Files.createTempDirectory("zygote");
+        Path socket = dir.resolve("z.sock").toAbsolutePath();
+
+        // No zygote listening: normal launch
+        OutputAnalyzer out = run(socket, "-version");
+        out.shouldHaveExitValue(0);
+        out.stderrShouldContain("version");
+
+        // The zygote runs the program and reports its status
+        List<String> received = new ArrayList<>();
+        Thread t = serve(socket, received, true, 42);
+        out = run(socket, "-version", "zygote-arg");
+        t.join();
+        out.shouldHaveExitValue(42);
+        out.stderrShouldNotContain("version \"");
+        if (!received.contains("-version") || !received.contains("zygote-arg")
+            || !received.contains("ZYGOTE_TEST=1")) {
+            throw new RuntimeException("unexpected request: " + received);
+        }
+
+        // The zygote declines: normal launch
+        t = serve(socket, received, false, 0);
+        out = run(socket, "-version");
+        t.join();
+        out.shouldHaveExitValue(0);
+        out.stderrShouldContain("version");
+    }
+
+    private static OutputAnalyzer run(Path socket, String... args)
+        throws Exception
+    {
+        List<String> cmd = new ArrayList<>();
+        cmd.add(JDKToolFinder.getJDKTool("java"));
+        cmd.addAll(List.of(args));
+        ProcessBuilder pb = new ProcessBuilder(cmd);
+        pb.environment().put("JDK_JAVA_ZYGOTE", socket.toString());
+        pb.environment().put("ZYGOTE_TEST", "1");
+        return ProcessTools.executeProcess(pb);
+    }
+
+    private static Thread serve(Path socket, List<String> received,
+                                boolean accept, int status)
+        throws IOException
+    {
+        Files.deleteIfExists(socket);
+        ServerSocketChannel server =
+            ServerSocketChannel.open(StandardProtocolFamily.UNIX);
+        server.bind(UnixDomainSocketAddress.of(socket));
+        Thread t = new Thread(() -> {
+            try (server; SocketChannel ch = server.accept()) {
+                ByteBuffer header = read(ch, 16);
+                if (header.getInt() != MAGIC) {
+                    throw new RuntimeException("bad magic");
+                }
+                int length = header.getInt();
+                ByteBuffer body = read(ch, length - 8);
+                received.clear();
+                for (String s : new String(body.array(), 0, body.limit(),
+                                           StandardCharsets.UTF_8)
+                                     .split("\0")) {
+                    received.add(s);
+                }
+                ByteBuffer reply = ByteBuffer.allocate(10)
+                                             .order(ByteOrder.nativeOrder());
+                if (accept) {
+                    reply.put((byte) 'A').putInt(1);
+                    reply.put((byte) 'X').putInt(status);
+                } else {
+                    reply.put((byte) 'D').putInt(0);
+                }
+                reply.flip();
+                while (reply.hasRemaining()) {
+                    ch.write(reply);
+                }
+            } catch (IOException e) {
+                throw new RuntimeException(e);
+            }
+        });
+        t.start();
+        return t;
+    }
+
+    private static ByteBuffer read(SocketChannel ch, int n) throws IOException {
+        ByteBuffer buf = ByteBuffer.allocate(n).order(ByteOrder.nativeOrder());
+        while (buf.hasRemaining()) {
+            if (ch.read(buf) < 0) {
+                throw new IOException("unexpected EOF");
+            }
+        }
+        buf.flip();
+        return buf;
+    }
+}
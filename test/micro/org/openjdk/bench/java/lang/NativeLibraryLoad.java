@@ -0,0 +1,123 @@
+/*
+ * Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+package org.openjdk.bench.java.lang;
+
+import org.openjdk.jmh.annotations.Benchmark;
+import org.openjdk.jmh.annotations.BenchmarkMode;
+import org.openjdk.jmh.annotations.Fork;
+import org.openjdk.jmh.annotations.Level;
+import org.openjdk.jmh.annotations.Measurement;
+import org.openjdk.jmh.annotations.Mode;
+import org.openjdk.jmh.annotations.OutputTimeUnit;
+import org.openjdk.jmh.annotations.Param;
+import org.openjdk.jmh.annotations.Scope;
+import org.openjdk.jmh.annotations.Setup;
+import org.openjdk.jmh.annotations.State;
+import org.openjdk.jmh.annotations.Warmup;
+
+import java.io.File;
+import java.io.IOException;
+import java.nio.file.Files;
+import java.nio.file.Path;
+import java.util.ArrayList;
+import java.util.List;
+import java.util.concurrent.ExecutorService;
+import java.util.concurrent.Executors;
+import java.util.concurrent.Future;
+import java.util.concurrent.TimeUnit;
+
+/**
+ * Startup cost of loading many JNI libraries, one after the other and
+ * from several threads, as applications with many native dependencies
+ * do. Every invocation loads fresh copies of the same library, so that
+ * each load opens a new library and runs its JNI_OnLoad.
+ */
+@BenchmarkMode(Mode.SingleShotTime)
+@Warmup(iterations = 5)
+@Measurement(iterations = 20)
+@State(Scope.Thread)
+@OutputTimeUnit(TimeUnit.MILLISECONDS)
+@Fork(value = 3)
+public class NativeLibraryLoad {
+
+    @Param({"32"})
+    public int libraries;
+
+    @Param({"8"})
+    public int threads;
+
+    private Path source;
+    private List<String> copies;
+    private int generation;
+
+    static native int loadCount();
+
+    @Setup(Level.Trial)
+    public void findLibrary() {
+        String name = System.mapLibraryName("NativeLibraryLoad");
+        for (String dir : System.getProperty("java.library.path").split(File.pathSeparator)) {
+            Path p = Path.of(dir, name);
+            if (Files.isRegularFile(p)) {
+                source = p;
+                return;
+            }
+        }
+        throw new IllegalStateException(name + " not found in java.library.path");
+    }
+
+    @Setup(Level.Invocation)
+    public void copyLibraries() throws IOException {
+        Path dir = Files.createTempDirectory("NativeLibraryLoad");
+        dir.toFile().deleteOnExit();
+        copies = new ArrayList<>();
+        for (int i = 0; i < libraries; i++) {
+            Path copy = dir.resolve(generation + "_" + i + "_" + source.getFileName());
+            Files.copy(source, copy);
+            copy.toFile().deleteOnExit();
+            copies.add(copy.toString());
+        }
+        generation++;
+    }
+
+    @Benchmark
+    public int loadSerially() {
+        for (String lib : copies) {
+            System.load(lib);
+        }
+        return loadCount();
+    }
+
+    @Benchmark
+    public int loadConcurrently() throws Exception {
+        try (ExecutorService pool = Executors.newFixedThreadPool(threads)) {
+            List<Future<?>> loads = new ArrayList<>();
+            for (String lib : copies) {
+                loads.add(pool.submit(() -> System.load(lib)));
+            }
+            for (Future<?> f : loads) {
+                f.get();
+            }
+        }
+        return loadCount();
+    }
+}
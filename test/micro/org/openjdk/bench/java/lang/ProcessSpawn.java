@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) 2026, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+package org.openjdk.bench.java.lang;
+
+import org.openjdk.jmh.annotations.Benchmark;
+import org.openjdk.jmh.annotations.BenchmarkMode;
+import org.openjdk.jmh.annotations.Fork;
+import org.openjdk.jmh.annotations.Measurement;
+import org.openjdk.jmh.annotations.Mode;
+import org.openjdk.jmh.annotations.OutputTimeUnit;
+import org.openjdk.jmh.annotations.Scope;
+import org.openjdk.jmh.annotations.State;
+import org.openjdk.jmh.annotations.Threads;
+import org.openjdk.jmh.annotations.Warmup;
+
+import java.io.IOException;
+import java.util.concurrent.TimeUnit;
+
+/**
+ * Throughput of launching short-lived processes, with a helper
+ * exec'd for every child (POSIX_SPAWN) and with a persistent
+ * spawn server (SPAWN_SERVER).
+ */
+@BenchmarkMode(Mode.Throughput)
+@Warmup(iterations = 5, time = 1)
+@Measurement(iterations = 5, time = 2)
+@State(Scope.Benchmark)
+@OutputTimeUnit(TimeUnit.SECONDS)
+public class ProcessSpawn {
+
+    private static final ProcessBuilder TRUE = new ProcessBuilder("true")
+            .redirectOutput(ProcessBuilder.Redirect.DISCARD)
+            .redirectErrorStream(true);
+
+    private static int spawn() throws IOException, InterruptedException {
+        return TRUE.start().waitFor();
+    }
+
+    @Benchmark
+    @Fork(value = 3, jvmArgsAppend = "-Djdk.lang.Process.launchMechanism=POSIX_SPAWN")
+    public int posixSpawn() throws Exception {
+        return spawn();
+    }
+
+    @Benchmark
+    @Fork(value = 3, jvmArgsAppend = "-Djdk.lang.Process.launchMechanism=SPAWN_SERVER")
+    public int spawnServer() throws Exception {
+        return spawn();
+    }
+
+    @Benchmark
+    @Threads(8)
+    @Fork(value = 3, jvmArgsAppend = "-Djdk.lang.Process.launchMechanism=POSIX_SPAWN")
+    public int posixSpawnConcurrent() throws Exception {
+        return spawn();
+    }
+
+    @Benchmark
+    @Threads(8)
+    @Fork(value = 3, jvmArgsAppend = "-Djdk.lang.Process.launchMechanism=SPAWN_SERVER")
+    public int spawnServerConcurrent() throws Exception {
+        return spawn();
+    }
+}